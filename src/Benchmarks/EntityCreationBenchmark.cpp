@@ -0,0 +1,69 @@
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+
+#include "Engine/Scene/World.h"
+
+// Creates 1M entities with Name + Transform + a 12-byte component, once one by
+// one (CreateEntity + AddComponent) and once through World::CreateEntities.
+// Usage: EntityCreationBenchmark [count] [runs]
+namespace
+{
+struct Velocity
+{
+    float x = 0.0f;
+    float y = 0.0f;
+    float z = 0.0f;
+};
+
+using Clock = std::chrono::steady_clock;
+
+double MillisecondsSince(const Clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+} // namespace
+
+int main(int argc, char** argv)
+{
+    const std::size_t count = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 1000000U;
+    const int runs = (argc > 2) ? std::atoi(argv[2]) : 3;
+
+    for (int run = 0; run < runs; ++run)
+    {
+        double singleMs = 0.0;
+        {
+            rg::World world;
+            const Clock::time_point start = Clock::now();
+            for (std::size_t index = 0; index < count; ++index)
+            {
+                const rg::Entity entity = world.CreateEntity("Particle");
+                world.GetRegistry().AddComponent<Velocity>(entity.GetId(), Velocity {1.0f, 2.0f, 3.0f});
+            }
+            singleMs = MillisecondsSince(start);
+        }
+
+        double batchMs = 0.0;
+        {
+            rg::World world;
+            const Clock::time_point start = Clock::now();
+            const auto entities = world.CreateEntities(count, "Particle", rg::TransformComponent {}, Velocity {1.0f, 2.0f, 3.0f});
+            batchMs = MillisecondsSince(start);
+            if (entities.size() != count)
+            {
+                std::fprintf(stderr, "CreateEntities returned %zu entities, expected %zu\n", entities.size(), count);
+                return 1;
+            }
+        }
+
+        std::printf(
+            "%zu entities: one by one %.1f ms (%.1f M/s), CreateEntities %.1f ms (%.1f M/s)\n",
+            count,
+            singleMs,
+            static_cast<double>(count) / singleMs / 1000.0,
+            batchMs,
+            static_cast<double>(count) / batchMs / 1000.0);
+    }
+    return 0;
+}
@@ -0,0 +1,121 @@
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+
+#include "Engine/Core/JobSystem.h"
+
+// Measures JobSystem overhead: 1M empty jobs spawned from the main thread, a
+// binary tree of ~2M jobs spawned by jobs, and a fork-join fib(32).
+// Usage: JobSpawnBenchmark [workers] [runs]
+namespace
+{
+using Clock = std::chrono::steady_clock;
+
+double NanosecondsPer(const Clock::time_point start, const Clock::time_point end, const double count)
+{
+    return std::chrono::duration<double, std::nano>(end - start).count() / count;
+}
+
+long Fib(rg::JobSystem& jobs, const int n)
+{
+    // Small subproblems run serially so leaves are not all spawn overhead.
+    if (n < 16)
+    {
+        long previous = 0;
+        long current = 1;
+        for (int index = 0; index < n; ++index)
+        {
+            const long next = previous + current;
+            previous = current;
+            current = next;
+        }
+        return previous;
+    }
+
+    long left = 0;
+    rg::JobCounter counter;
+    jobs.Spawn(counter, [&jobs, &left, n]()
+    {
+        left = Fib(jobs, n - 1);
+    });
+    const long right = Fib(jobs, n - 2);
+    jobs.Wait(counter);
+    return left + right;
+}
+
+void SpawnTree(rg::JobSystem& jobs, rg::JobCounter& counter, const int depth, std::atomic<long>& leaves)
+{
+    if (depth == 0)
+    {
+        leaves.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    for (int child = 0; child < 2; ++child)
+    {
+        jobs.Spawn(counter, [&jobs, &counter, depth, &leaves]()
+        {
+            SpawnTree(jobs, counter, depth - 1, leaves);
+        });
+    }
+}
+} // namespace
+
+int main(int argc, char** argv)
+{
+    const unsigned hardwareThreads = std::thread::hardware_concurrency();
+    const std::size_t workers = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : ((hardwareThreads > 1U) ? hardwareThreads - 1U : 0U);
+    const int runs = (argc > 2) ? std::atoi(argv[2]) : 3;
+    rg::JobSystem jobs(workers);
+    std::printf("workers=%zu\n", jobs.WorkerCount());
+
+    constexpr int kFlatJobs = 1000000;
+    constexpr int kTreeDepth = 20;
+    constexpr double kTreeJobs = static_cast<double>((1L << (kTreeDepth + 1)) - 2);
+    for (int run = 0; run < runs; ++run)
+    {
+        std::atomic<int> executed {0};
+        const Clock::time_point flatStart = Clock::now();
+        {
+            rg::JobCounter counter;
+            for (int index = 0; index < kFlatJobs; ++index)
+            {
+                jobs.Spawn(counter, [&executed]()
+                {
+                    executed.fetch_add(1, std::memory_order_relaxed);
+                });
+            }
+            jobs.Wait(counter);
+        }
+        const Clock::time_point flatEnd = Clock::now();
+
+        std::atomic<long> leaves {0};
+        const Clock::time_point treeStart = Clock::now();
+        {
+            rg::JobCounter counter;
+            SpawnTree(jobs, counter, kTreeDepth, leaves);
+            jobs.Wait(counter);
+        }
+        const Clock::time_point treeEnd = Clock::now();
+
+        const Clock::time_point fibStart = Clock::now();
+        const long fib = Fib(jobs, 32);
+        const Clock::time_point fibEnd = Clock::now();
+
+        if ((executed.load() != kFlatJobs) || (leaves.load() != (1L << kTreeDepth)) || (fib != 2178309))
+        {
+            std::fprintf(stderr, "JobSystem returned wrong results\n");
+            return 1;
+        }
+
+        std::printf(
+            "flat spawn from main: %.0f ns/job | recursive tree: %.0f ns/job | fib(32) fork-join: %.1f ms\n",
+            NanosecondsPer(flatStart, flatEnd, kFlatJobs),
+            NanosecondsPer(treeStart, treeEnd, kTreeJobs),
+            NanosecondsPer(fibStart, fibEnd, 1.0e6));
+    }
+    return 0;
+}
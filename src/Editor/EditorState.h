@@ -1,6 +1,8 @@
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
+#include <string>
 
 #include "Engine/ECS/Registry.h"
 
@@ -17,5 +19,12 @@ struct EditorFrameStats
     float deltaSeconds = 0.0f;
     std::uint64_t frameIndex = 0;
     const char* rendererBackend = "None";
+    // System scheduler timings of the previous frame.
+    float systemsMs = 0.0f;
+    float criticalPathMs = 0.0f;
+    std::string criticalPath;
+    // Frame arena usage so far this frame / reserved by both arenas.
+    std::size_t frameMemoryUsed = 0;
+    std::size_t frameMemoryCapacity = 0;
 };
 } // namespace rg::editor
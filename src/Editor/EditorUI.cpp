@@ -422,7 +422,7 @@ void EditorUI::DrawDebugMenu(EditorContext& context)
             for (int x = 0; x < 4; ++x)
             {
                 Entity entity = context.world.CreateEntity("DebugEntity");
-                entity.Transform().position = Vector3 {static_cast<float>(x * 2), 0.0f, static_cast<float>(z * 2)};
+                entity.MutableTransform().position = Vector3 {static_cast<float>(x * 2), 0.0f, static_cast<float>(z * 2)};
             }
         }
         m_lastActionMessage = "Spawned 16 test entities.";
@@ -496,7 +496,7 @@ void EditorUI::SaveLevel(const World& world, const std::filesystem::path& path)
         {
             const RigidbodyComponent& body = entity.GetComponent<RigidbodyComponent>();
             file << "RIGIDBODY "
-                 << body.mass << ' ' << body.useGravity << ' ' << body.isKinematic << ' '
+                 << body.mass << ' ' << body.useGravity << ' ' << entity.HasComponent<KinematicTag>() << ' '
                  << body.velocity.x << ' ' << body.velocity.y << ' ' << body.velocity.z << '\n';
         }
 
@@ -543,6 +543,7 @@ void EditorUI::LoadLevel(World& world, EditorState& state, const std::filesystem
         MeshComponent mesh {};
         bool hasRigidbody = false;
         RigidbodyComponent rigidbody {};
+        bool kinematic = false;
         bool hasVoxelPlayer = false;
         VoxelPlayerComponent voxelPlayer {};
     };
@@ -588,7 +589,7 @@ void EditorUI::LoadLevel(World& world, EditorState& state, const std::filesystem
             else if (token == "RIGIDBODY")
             {
                 data.hasRigidbody = true;
-                file >> data.rigidbody.mass >> data.rigidbody.useGravity >> data.rigidbody.isKinematic;
+                file >> data.rigidbody.mass >> data.rigidbody.useGravity >> data.kinematic;
                 file >> data.rigidbody.velocity.x >> data.rigidbody.velocity.y >> data.rigidbody.velocity.z;
             }
             else if (token == "VOXEL_PLAYER")
@@ -602,23 +603,27 @@ void EditorUI::LoadLevel(World& world, EditorState& state, const std::filesystem
         }
 
         Entity entity = world.CreateEntity(data.name);
-        entity.Transform() = data.transform;
+        entity.MutableTransform() = data.transform;
 
         if (data.hasScript)
         {
             entity.AttachScript(data.script.className);
-            entity.Script().enabled = data.script.enabled;
+            entity.MutableScript().enabled = data.script.enabled;
         }
 
         if (data.hasMesh)
         {
             entity.AttachMesh(data.mesh.meshAsset, data.mesh.materialAsset);
-            entity.Mesh().visible = data.mesh.visible;
+            entity.MutableMesh().visible = data.mesh.visible;
         }
 
         if (data.hasRigidbody)
         {
             entity.AddComponent<RigidbodyComponent>(data.rigidbody);
+            if (data.kinematic)
+            {
+                entity.AddComponent<KinematicTag>();
+            }
         }
 
         if (data.hasVoxelPlayer)
@@ -639,24 +644,29 @@ Entity EditorUI::DuplicateEntity(EditorContext& context, const Entity source)
     }
 
     Entity duplicated = context.world.CreateEntity(source.GetName() + " Copy");
-    duplicated.Transform() = source.Transform();
-    duplicated.Transform().position.x += 1.0f;
+    TransformComponent& transform = duplicated.MutableTransform();
+    transform = source.Transform();
+    transform.position.x += 1.0f;
 
     if (source.HasScript())
     {
         duplicated.AttachScript(source.Script().className);
-        duplicated.Script().enabled = source.Script().enabled;
+        duplicated.MutableScript().enabled = source.Script().enabled;
     }
 
     if (source.HasMesh())
     {
         duplicated.AttachMesh(source.Mesh().meshAsset, source.Mesh().materialAsset);
-        duplicated.Mesh().visible = source.Mesh().visible;
+        duplicated.MutableMesh().visible = source.Mesh().visible;
     }
 
     if (source.HasComponent<RigidbodyComponent>())
     {
         duplicated.AddComponent<RigidbodyComponent>(source.GetComponent<RigidbodyComponent>());
+        if (source.HasComponent<KinematicTag>())
+        {
+            duplicated.AddComponent<KinematicTag>();
+        }
     }
 
     if (source.HasComponent<VoxelPlayerComponent>())
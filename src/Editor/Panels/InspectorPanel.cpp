@@ -13,15 +13,17 @@ namespace rg::editor
 {
 namespace
 {
-void EditVector3(const char* label, Vector3& value)
+bool EditVector3(const char* label, Vector3& value)
 {
     float raw[3] {value.x, value.y, value.z};
-    if (ImGui::DragFloat3(label, raw, 0.05f))
+    if (!ImGui::DragFloat3(label, raw, 0.05f))
     {
-        value.x = raw[0];
-        value.y = raw[1];
-        value.z = raw[2];
+        return false;
     }
+    value.x = raw[0];
+    value.y = raw[1];
+    value.z = raw[2];
+    return true;
 }
 
 std::array<char, 256> ToBuffer(const std::string& value)
@@ -59,20 +61,29 @@ void InspectorPanel::Draw(EditorContext& context)
 
     ImGui::SeparatorText("Transform");
     TransformComponent& transform = entity.Transform();
-    EditVector3("Position", transform.position);
-    EditVector3("Rotation", transform.rotation);
-    EditVector3("Scale", transform.scale);
+    bool transformEdited = EditVector3("Position", transform.position);
+    transformEdited |= EditVector3("Rotation", transform.rotation);
+    transformEdited |= EditVector3("Scale", transform.scale);
+    if (transformEdited)
+    {
+        entity.MarkTransformChanged();
+    }
 
     if (entity.HasScript())
     {
         ImGui::SeparatorText("Script");
         ScriptComponent& script = entity.Script();
-        ImGui::Checkbox("Enabled", &script.enabled);
+        bool scriptEdited = ImGui::Checkbox("Enabled", &script.enabled);
 
         auto scriptBuffer = ToBuffer(script.className);
         if (ImGui::InputText("Class", scriptBuffer.data(), scriptBuffer.size()))
         {
             script.className = scriptBuffer.data();
+            scriptEdited = true;
+        }
+        if (scriptEdited)
+        {
+            entity.MarkScriptChanged();
         }
     }
 
@@ -80,18 +91,24 @@ void InspectorPanel::Draw(EditorContext& context)
     {
         ImGui::SeparatorText("Mesh");
         MeshComponent& mesh = entity.Mesh();
-        ImGui::Checkbox("Visible", &mesh.visible);
+        bool meshEdited = ImGui::Checkbox("Visible", &mesh.visible);
 
         auto meshBuffer = ToBuffer(mesh.meshAsset);
         if (ImGui::InputText("Mesh Asset", meshBuffer.data(), meshBuffer.size()))
         {
             mesh.meshAsset = meshBuffer.data();
+            meshEdited = true;
         }
 
         auto materialBuffer = ToBuffer(mesh.materialAsset);
         if (ImGui::InputText("Material Asset", materialBuffer.data(), materialBuffer.size()))
         {
             mesh.materialAsset = materialBuffer.data();
+            meshEdited = true;
+        }
+        if (meshEdited)
+        {
+            entity.MarkMeshChanged();
         }
     }
 
@@ -99,7 +116,18 @@ void InspectorPanel::Draw(EditorContext& context)
     {
         ImGui::SeparatorText("Rigidbody");
         RigidbodyComponent& rigidbody = entity.GetComponent<RigidbodyComponent>();
-        ImGui::Checkbox("Kinematic", &rigidbody.isKinematic);
+        bool kinematic = entity.HasComponent<KinematicTag>();
+        if (ImGui::Checkbox("Kinematic", &kinematic))
+        {
+            if (kinematic)
+            {
+                entity.AddComponent<KinematicTag>();
+            }
+            else
+            {
+                entity.RemoveComponent<KinematicTag>();
+            }
+        }
         ImGui::Checkbox("Use Gravity", &rigidbody.useGravity);
         ImGui::DragFloat("Mass", &rigidbody.mass, 0.1f, 0.01f, 1000.0f);
         EditVector3("Velocity", rigidbody.velocity);
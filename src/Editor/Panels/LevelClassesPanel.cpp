@@ -3,6 +3,7 @@
 #include <map>
 #include <string>
 
+#include "Engine/Core/FrameAllocator.h"
 #include "Engine/Scene/Components.h"
 
 #if defined(RG_WITH_IMGUI) && RG_WITH_IMGUI
@@ -26,7 +27,7 @@ void LevelClassesPanel::Draw(EditorContext& context)
     std::size_t voxelPlayerCount = 0;
     std::map<std::string, std::size_t> scriptClasses;
 
-    for (const Entity entity : context.world.Entities())
+    for (const Entity entity : context.world.Entities(FrameAllocator::Shared().Resource()))
     {
         if (entity.HasComponent<NameComponent>())
         {
@@ -85,8 +86,9 @@ void LevelClassesPanel::Draw(EditorContext& context)
         {
             if (selected.HasScript())
             {
-                selected.Script().className = className;
-                selected.Script().enabled = true;
+                ScriptComponent& script = selected.MutableScript();
+                script.className = className;
+                script.enabled = true;
             }
             else
             {
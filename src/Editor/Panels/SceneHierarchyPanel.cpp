@@ -2,6 +2,8 @@
 
 #include <string>
 
+#include "Engine/Core/FrameAllocator.h"
+
 #if defined(RG_WITH_IMGUI) && RG_WITH_IMGUI
 #include <imgui.h>
 #endif
@@ -24,7 +26,7 @@ void SceneHierarchyPanel::Draw(EditorContext& context)
 
     ImGui::Separator();
 
-    for (const Entity entity : context.world.Entities())
+    for (const Entity entity : context.world.Entities(FrameAllocator::Shared().Resource()))
     {
         const bool selected = (context.state.selectedEntity == entity.GetId());
         std::string label = entity.GetName() + "##" + std::to_string(entity.GetId());
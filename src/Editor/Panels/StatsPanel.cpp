@@ -24,6 +24,12 @@ void StatsPanel::Draw(EditorContext& context)
     ImGui::Text("Renderer: %s", context.stats.rendererBackend);
     ImGui::Text("Frame time: %.3f ms", deltaMs);
     ImGui::Text("FPS: %.1f", fps);
+    ImGui::Text("Systems: %.3f ms (critical path %.3f ms)", context.stats.systemsMs, context.stats.criticalPathMs);
+    ImGui::TextWrapped("Critical path: %s", context.stats.criticalPath.c_str());
+    ImGui::Text(
+        "Frame memory: %.1f / %.1f KiB",
+        static_cast<double>(context.stats.frameMemoryUsed) / 1024.0,
+        static_cast<double>(context.stats.frameMemoryCapacity) / 1024.0);
     ImGui::Text("Entities: %zu", context.world.EntityCount());
     ImGui::Checkbox("Show ImGui Demo", &context.state.showDemoWindow);
 
@@ -4,6 +4,7 @@
 #include <cmath>
 #include <string>
 
+#include "Engine/Core/FrameAllocator.h"
 #include "Engine/Scene/Components.h"
 #include "Game/Minecraft/VoxelWorld.h"
 
@@ -178,7 +179,7 @@ void ViewportPanel::Draw(EditorContext& context)
 
     float nearestDistanceSq = 36.0f;
     ecs::EntityId hoveredEntity = ecs::InvalidEntity;
-    for (const Entity entity : context.world.Entities())
+    for (const Entity entity : context.world.Entities(FrameAllocator::Shared().Resource()))
     {
         const TransformComponent& transform = entity.Transform();
         const ImVec2 marker = WorldToScreen(
@@ -241,8 +242,9 @@ void ViewportPanel::Draw(EditorContext& context)
             const ImVec2 mouse = ImGui::GetIO().MousePos;
             const float worldX = centerX + ((mouse.x - canvasCenter.x) / m_zoomPixelsPerMeter);
             const float worldZ = centerZ - ((mouse.y - canvasCenter.y) / m_zoomPixelsPerMeter);
-            dragEntity.Transform().position.x = worldX;
-            dragEntity.Transform().position.z = worldZ;
+            TransformComponent& transform = dragEntity.MutableTransform();
+            transform.position.x = worldX;
+            transform.position.z = worldZ;
         }
     }
 
@@ -0,0 +1,165 @@
+#include "Engine/Core/FrameAllocator.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <new>
+
+namespace rg
+{
+LinearArena::LinearArena(const std::size_t blockSize) : m_blockSize(std::max<std::size_t>(blockSize, 64U))
+{
+}
+
+void* LinearArena::Allocate(const std::size_t size, const std::size_t alignment)
+{
+    Block* block = m_current.load(std::memory_order_acquire);
+    if (block != nullptr)
+    {
+        if (void* pointer = TryAllocate(*block, size, alignment))
+        {
+            return pointer;
+        }
+    }
+    return AllocateSlow(block, size, alignment);
+}
+
+void* LinearArena::TryAllocate(Block& block, const std::size_t size, const std::size_t alignment)
+{
+    const auto base = reinterpret_cast<std::uintptr_t>(block.memory.get());
+    std::size_t used = block.used.load(std::memory_order_relaxed);
+    while (true)
+    {
+        const std::uintptr_t aligned = (base + used + alignment - 1U) & ~(static_cast<std::uintptr_t>(alignment) - 1U);
+        const std::size_t end = static_cast<std::size_t>(aligned - base) + size;
+        if (end > block.size)
+        {
+            return nullptr;
+        }
+        if (block.used.compare_exchange_weak(used, end, std::memory_order_relaxed))
+        {
+            return reinterpret_cast<void*>(aligned);
+        }
+    }
+}
+
+void* LinearArena::AllocateSlow(Block* exhausted, const std::size_t size, const std::size_t alignment)
+{
+    std::lock_guard<std::mutex> lock(m_growMutex);
+
+    // Another thread may have grown the arena while this one waited.
+    Block* current = m_current.load(std::memory_order_acquire);
+    if ((current != exhausted) && (current != nullptr))
+    {
+        if (void* pointer = TryAllocate(*current, size, alignment))
+        {
+            return pointer;
+        }
+    }
+
+    if (current != nullptr)
+    {
+        m_retiredBytes += current->used.load(std::memory_order_relaxed);
+    }
+
+    auto block = std::make_unique<Block>();
+    block->size = std::max(m_blockSize, size + alignment);
+    block->memory.reset(new std::byte[block->size]);
+    void* pointer = TryAllocate(*block, size, alignment);
+    if (pointer == nullptr)
+    {
+        throw std::bad_alloc();
+    }
+
+    m_current.store(block.get(), std::memory_order_release);
+    m_blocks.push_back(std::move(block));
+    return pointer;
+}
+
+void LinearArena::Reset()
+{
+    std::lock_guard<std::mutex> lock(m_growMutex);
+    if (m_blocks.size() > 1U)
+    {
+        // Fold the blocks of an overflowing cycle into one that fits its peak.
+        m_blockSize = std::max(m_blockSize, Capacity());
+        m_blocks.clear();
+        m_current.store(nullptr, std::memory_order_release);
+    }
+    else if (!m_blocks.empty())
+    {
+        m_blocks.front()->used.store(0, std::memory_order_relaxed);
+    }
+    m_retiredBytes = 0;
+}
+
+std::size_t LinearArena::BytesUsed() const
+{
+    const Block* current = m_current.load(std::memory_order_acquire);
+    return m_retiredBytes + ((current != nullptr) ? current->used.load(std::memory_order_relaxed) : 0U);
+}
+
+std::size_t LinearArena::Capacity() const
+{
+    std::size_t capacity = 0;
+    for (const auto& block : m_blocks)
+    {
+        capacity += block->size;
+    }
+    return capacity;
+}
+
+FrameAllocator::FrameAllocator() : m_resource(*this)
+{
+}
+
+FrameAllocator& FrameAllocator::Shared()
+{
+    static FrameAllocator allocator;
+    return allocator;
+}
+
+void FrameAllocator::BeginFrame()
+{
+    const std::size_t next = 1U - m_current.load(std::memory_order_relaxed);
+    m_arenas[next].Reset();
+    m_current.store(next, std::memory_order_release);
+}
+
+void* FrameAllocator::Allocate(const std::size_t size, const std::size_t alignment)
+{
+    return m_arenas[m_current.load(std::memory_order_acquire)].Allocate(size, alignment);
+}
+
+std::pmr::memory_resource* FrameAllocator::Resource()
+{
+    return &m_resource;
+}
+
+std::size_t FrameAllocator::BytesUsed() const
+{
+    return m_arenas[m_current.load(std::memory_order_acquire)].BytesUsed();
+}
+
+std::size_t FrameAllocator::Capacity() const
+{
+    return m_arenas[0].Capacity() + m_arenas[1].Capacity();
+}
+
+void* FrameAllocator::MemoryResource::do_allocate(const std::size_t bytes, const std::size_t alignment)
+{
+    return m_owner.Allocate(bytes, alignment);
+}
+
+void FrameAllocator::MemoryResource::do_deallocate(void* pointer, const std::size_t bytes, const std::size_t alignment)
+{
+    // Released wholesale when the arena is reset.
+    (void)pointer;
+    (void)bytes;
+    (void)alignment;
+}
+
+bool FrameAllocator::MemoryResource::do_is_equal(const std::pmr::memory_resource& other) const noexcept
+{
+    return this == &other;
+}
+} // namespace rg
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <vector>
+
+namespace rg
+{
+// Bump allocator: allocations advance an offset into the current block and are
+// only ever released all at once by Reset(). Allocation is lock-free except when
+// a block runs out, so jobs can allocate concurrently. After a Reset() that
+// followed an overflow, the arena re-allocates a single block large enough for
+// the whole previous peak, so steady-state frames touch one block.
+class LinearArena
+{
+public:
+    static constexpr std::size_t kDefaultBlockSize = 1U << 20U;
+
+    explicit LinearArena(std::size_t blockSize = kDefaultBlockSize);
+
+    LinearArena(const LinearArena&) = delete;
+    LinearArena& operator=(const LinearArena&) = delete;
+
+    [[nodiscard]] void* Allocate(std::size_t size, std::size_t alignment);
+
+    // Invalidates every allocation. Must not run concurrently with Allocate().
+    void Reset();
+
+    [[nodiscard]] std::size_t BytesUsed() const;
+    [[nodiscard]] std::size_t Capacity() const;
+
+private:
+    struct Block
+    {
+        std::unique_ptr<std::byte[]> memory;
+        std::size_t size = 0;
+        std::atomic<std::size_t> used {0};
+    };
+
+    [[nodiscard]] void* AllocateSlow(Block* exhausted, std::size_t size, std::size_t alignment);
+    [[nodiscard]] static void* TryAllocate(Block& block, std::size_t size, std::size_t alignment);
+
+    std::size_t m_blockSize = kDefaultBlockSize;
+    std::atomic<Block*> m_current {nullptr};
+    std::mutex m_growMutex;
+    std::vector<std::unique_ptr<Block>> m_blocks;
+    // Bytes held by blocks that are no longer current in this cycle.
+    std::size_t m_retiredBytes = 0;
+};
+
+// Transient per-frame memory. Two arenas alternate: BeginFrame() makes the older
+// one current and resets it, so an allocation stays valid until the end of the
+// frame after the one that made it (long enough to hand data to a consumer one
+// frame behind). Resource() is a std::pmr adapter over whichever arena is
+// current; deallocation through it is a no-op.
+class FrameAllocator
+{
+public:
+    FrameAllocator();
+
+    FrameAllocator(const FrameAllocator&) = delete;
+    FrameAllocator& operator=(const FrameAllocator&) = delete;
+
+    // Process-wide instance advanced by the engine loop.
+    [[nodiscard]] static FrameAllocator& Shared();
+
+    // Call once per frame while no job is allocating.
+    void BeginFrame();
+
+    [[nodiscard]] void* Allocate(std::size_t size, std::size_t alignment = alignof(std::max_align_t));
+    [[nodiscard]] std::pmr::memory_resource* Resource();
+
+    [[nodiscard]] std::size_t BytesUsed() const;
+    [[nodiscard]] std::size_t Capacity() const;
+
+private:
+    class MemoryResource final : public std::pmr::memory_resource
+    {
+    public:
+        explicit MemoryResource(FrameAllocator& owner) : m_owner(owner)
+        {
+        }
+
+    private:
+        void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+        void do_deallocate(void* pointer, std::size_t bytes, std::size_t alignment) override;
+        [[nodiscard]] bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+        FrameAllocator& m_owner;
+    };
+
+    LinearArena m_arenas[2];
+    std::atomic<std::size_t> m_current {0};
+    MemoryResource m_resource;
+};
+} // namespace rg
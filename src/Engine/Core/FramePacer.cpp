@@ -0,0 +1,103 @@
+#include "Engine/Core/FramePacer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#include <mmsystem.h>
+#endif
+
+namespace rg
+{
+namespace
+{
+constexpr auto kSleepSlice = std::chrono::milliseconds(1);
+// Samples older than this many are forgotten so the estimate follows changes in
+// system load.
+constexpr std::uint64_t kMaxSleepSamples = 1000;
+} // namespace
+
+FramePacer::FramePacer(const double framesPerSecond)
+{
+    if (framesPerSecond > 0.0)
+    {
+        m_period = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / framesPerSecond));
+#if defined(_WIN32)
+        // 1 ms scheduler granularity instead of the default ~15.6 ms.
+        m_raisedTimerResolution = (timeBeginPeriod(1) == TIMERR_NOERROR);
+#endif
+    }
+    m_nextFrame = Clock::now() + m_period;
+}
+
+FramePacer::~FramePacer()
+{
+#if defined(_WIN32)
+    if (m_raisedTimerResolution)
+    {
+        timeEndPeriod(1);
+    }
+#endif
+}
+
+bool FramePacer::IsUncapped() const
+{
+    return m_period == Clock::duration::zero();
+}
+
+void FramePacer::WaitForNextFrame()
+{
+    if (IsUncapped())
+    {
+        return;
+    }
+
+    while (true)
+    {
+        const double remaining = std::chrono::duration<double>(m_nextFrame - Clock::now()).count();
+        if (remaining <= m_sleepEstimate)
+        {
+            break;
+        }
+        SleepSlice();
+    }
+
+    while (Clock::now() < m_nextFrame)
+    {
+        std::this_thread::yield();
+    }
+
+    // A frame that overran by more than a period starts a new schedule instead of
+    // running a burst of unpaced frames to catch up.
+    m_nextFrame += m_period;
+    const Clock::time_point now = Clock::now();
+    if (m_nextFrame < now)
+    {
+        m_nextFrame = now + m_period;
+    }
+}
+
+void FramePacer::SleepSlice()
+{
+    const Clock::time_point start = Clock::now();
+    std::this_thread::sleep_for(kSleepSlice);
+    const double observed = std::chrono::duration<double>(Clock::now() - start).count();
+
+    if (m_sleepSamples >= kMaxSleepSamples)
+    {
+        m_sleepSamples = kMaxSleepSamples / 2;
+        m_sleepM2 *= 0.5;
+    }
+
+    ++m_sleepSamples;
+    const double delta = observed - m_sleepMean;
+    m_sleepMean += delta / static_cast<double>(m_sleepSamples);
+    m_sleepM2 += delta * (observed - m_sleepMean);
+    const double deviation = std::sqrt(m_sleepM2 / static_cast<double>(m_sleepSamples - 1));
+    m_sleepEstimate = std::max(m_sleepMean + deviation, 0.0);
+}
+} // namespace rg
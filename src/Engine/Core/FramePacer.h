@@ -0,0 +1,43 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+namespace rg
+{
+// Holds the main loop to a target frame rate. Sleeping alone oversleeps by the OS
+// timer granularity, spinning alone burns a core, so the pacer sleeps in short
+// slices while the remaining time is above its running estimate of how long a
+// slice really takes, then spins (yielding) up to the deadline. Deadlines advance
+// by a fixed period, so small late wake-ups do not accumulate into drift.
+class FramePacer
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    // framesPerSecond <= 0 means uncapped: WaitForNextFrame returns immediately.
+    explicit FramePacer(double framesPerSecond);
+    ~FramePacer();
+
+    FramePacer(const FramePacer&) = delete;
+    FramePacer& operator=(const FramePacer&) = delete;
+
+    [[nodiscard]] bool IsUncapped() const;
+
+    // Blocks until the start of the next frame period.
+    void WaitForNextFrame();
+
+private:
+    void SleepSlice();
+
+    Clock::duration m_period {};
+    Clock::time_point m_nextFrame {};
+    // Running mean/variance (Welford) of how long a 1 ms sleep actually takes, in
+    // seconds; mean + one deviation is the margin kept for spinning.
+    double m_sleepEstimate = 0.005;
+    double m_sleepMean = 0.005;
+    double m_sleepM2 = 0.0;
+    std::uint64_t m_sleepSamples = 1;
+    bool m_raisedTimerResolution = false;
+};
+} // namespace rg
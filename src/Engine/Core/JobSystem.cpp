@@ -0,0 +1,317 @@
+#include "Engine/Core/JobSystem.h"
+
+#include <algorithm>
+#include <deque>
+#include <iterator>
+#include <string>
+#include <utility>
+
+#include "Engine/Core/Profiler.h"
+
+namespace rg
+{
+namespace
+{
+// Idle rounds (each a yield) before a thread sleeps on the wake condition.
+constexpr std::size_t kSpinRounds = 64;
+
+thread_local const JobSystem* t_owner = nullptr;
+thread_local std::size_t t_workerIndex = 0;
+} // namespace
+
+struct JobSystem::Queue
+{
+    std::mutex mutex;
+    std::deque<Task> tasks;
+};
+
+JobSystem::JobSystem(const std::size_t workerCount)
+{
+    m_queues.reserve(workerCount + 1);
+    for (std::size_t i = 0; i < workerCount + 1; ++i)
+    {
+        m_queues.push_back(std::make_unique<Queue>());
+    }
+
+    m_workers.reserve(workerCount);
+    for (std::size_t i = 0; i < workerCount; ++i)
+    {
+        m_workers.emplace_back([this, i]()
+        {
+            WorkerLoop(i);
+        });
+    }
+}
+
+JobSystem::~JobSystem()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+        m_stopping.store(true);
+    }
+    m_wake.notify_all();
+
+    for (auto& worker : m_workers)
+    {
+        worker.join();
+    }
+}
+
+JobSystem& JobSystem::Shared()
+{
+    static JobSystem system(std::max(1U, std::thread::hardware_concurrency()) - 1U);
+    return system;
+}
+
+std::size_t JobSystem::WorkerCount() const
+{
+    return m_workers.size();
+}
+
+void JobSystem::Spawn(JobCounter& counter, Job job)
+{
+    counter.m_pending.fetch_add(1);
+
+    Queue& queue = *m_queues[CurrentQueueIndex()];
+    {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.tasks.push_back(Task {std::move(job), &counter});
+    }
+    m_queuedTasks.fetch_add(1);
+
+    if (m_sleepers.load() > 0)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_sleepMutex);
+        }
+        m_wake.notify_one();
+    }
+}
+
+void JobSystem::Wait(JobCounter& counter)
+{
+    const std::size_t self = CurrentQueueIndex();
+    std::size_t idleRounds = 0;
+    while (counter.m_pending.load() != 0)
+    {
+        if (TryRunOne(self))
+        {
+            idleRounds = 0;
+            continue;
+        }
+
+        if (++idleRounds < kSpinRounds)
+        {
+            std::this_thread::yield();
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(m_sleepMutex);
+        m_sleepers.fetch_add(1);
+        m_wake.wait(lock, [this, &counter]()
+        {
+            return (counter.m_pending.load() == 0) || (m_queuedTasks.load() > 0);
+        });
+        m_sleepers.fetch_sub(1);
+        idleRounds = 0;
+    }
+
+    if (counter.m_failed.load())
+    {
+        std::exception_ptr error;
+        {
+            std::lock_guard<std::mutex> lock(counter.m_errorMutex);
+            error = std::exchange(counter.m_error, nullptr);
+        }
+        counter.m_failed.store(false);
+        std::rethrow_exception(error);
+    }
+}
+
+bool JobSystem::RunPendingJob()
+{
+    return TryRunOne(CurrentQueueIndex());
+}
+
+bool JobSystem::RunPendingJob(const JobCounter& counter)
+{
+    return TryRunOne(CurrentQueueIndex(), &counter);
+}
+
+void JobSystem::ParallelFor(const std::size_t count, const std::size_t minChunk, const RangeFunc& func)
+{
+    if (count == 0)
+    {
+        return;
+    }
+
+    const std::size_t grain = std::max<std::size_t>(1, minChunk);
+    if (m_workers.empty() || (count <= grain))
+    {
+        func(0, count);
+        return;
+    }
+
+    // A few chunks per thread keeps uneven chunks from serializing the tail.
+    const std::size_t maxChunks = (m_workers.size() + 1) * 4;
+    const std::size_t chunkCount = std::min((count + grain - 1) / grain, maxChunks);
+    const std::size_t chunkSize = (count + chunkCount - 1) / chunkCount;
+
+    JobCounter counter;
+    for (std::size_t begin = 0; begin < count; begin += chunkSize)
+    {
+        const std::size_t end = std::min(begin + chunkSize, count);
+        Spawn(counter, [&func, begin, end]()
+        {
+            func(begin, end);
+        });
+    }
+    Wait(counter);
+}
+
+void JobSystem::WorkerLoop(const std::size_t index)
+{
+    t_owner = this;
+    t_workerIndex = index;
+    Profiler::SetThreadName(("Job worker " + std::to_string(index)).c_str());
+
+    std::size_t idleRounds = 0;
+    while (true)
+    {
+        if (TryRunOne(index))
+        {
+            idleRounds = 0;
+            continue;
+        }
+
+        if (++idleRounds < kSpinRounds)
+        {
+            std::this_thread::yield();
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(m_sleepMutex);
+        m_sleepers.fetch_add(1);
+        m_wake.wait(lock, [this]()
+        {
+            return m_stopping.load() || (m_queuedTasks.load() > 0);
+        });
+        m_sleepers.fetch_sub(1);
+        idleRounds = 0;
+
+        if (m_stopping.load() && (m_queuedTasks.load() == 0))
+        {
+            return;
+        }
+    }
+}
+
+bool JobSystem::TryRunOne(const std::size_t selfIndex, const JobCounter* counter)
+{
+    Task task;
+    if (!TryTake(selfIndex, task, counter))
+    {
+        return false;
+    }
+
+    Execute(task);
+    return true;
+}
+
+bool JobSystem::TryTake(const std::size_t selfIndex, Task& task, const JobCounter* counter)
+{
+    if (m_queuedTasks.load() == 0)
+    {
+        return false;
+    }
+
+    const std::size_t queueCount = m_queues.size();
+    for (std::size_t offset = 0; offset < queueCount; ++offset)
+    {
+        const std::size_t victim = (selfIndex + offset) % queueCount;
+        Queue& queue = *m_queues[victim];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.tasks.empty())
+        {
+            continue;
+        }
+
+        // A filtered take searches in the same order and removes just that job.
+        if (counter != nullptr)
+        {
+            const auto matches = [counter](const Task& queued)
+            {
+                return queued.counter == counter;
+            };
+            auto match = queue.tasks.end();
+            if (offset == 0)
+            {
+                const auto newest = std::find_if(queue.tasks.rbegin(), queue.tasks.rend(), matches);
+                match = (newest != queue.tasks.rend()) ? std::prev(newest.base()) : queue.tasks.end();
+            }
+            else
+            {
+                match = std::find_if(queue.tasks.begin(), queue.tasks.end(), matches);
+            }
+            if (match == queue.tasks.end())
+            {
+                continue;
+            }
+
+            task = std::move(*match);
+            queue.tasks.erase(match);
+            m_queuedTasks.fetch_sub(1);
+            return true;
+        }
+
+        // A thread takes the newest job of its own queue (external threads share
+        // the injection queue) and steals the oldest job of any other queue.
+        if (offset == 0)
+        {
+            task = std::move(queue.tasks.back());
+            queue.tasks.pop_back();
+        }
+        else
+        {
+            task = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+        }
+        m_queuedTasks.fetch_sub(1);
+        return true;
+    }
+    return false;
+}
+
+void JobSystem::Execute(Task& task)
+{
+    JobCounter& counter = *task.counter;
+    try
+    {
+        task.job();
+    }
+    catch (...)
+    {
+        std::lock_guard<std::mutex> lock(counter.m_errorMutex);
+        if (counter.m_error == nullptr)
+        {
+            counter.m_error = std::current_exception();
+        }
+        counter.m_failed.store(true);
+    }
+    task.job = nullptr;
+
+    // The counter may be destroyed by its waiter as soon as it reaches zero.
+    if ((counter.m_pending.fetch_sub(1) == 1) && (m_sleepers.load() > 0))
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_sleepMutex);
+        }
+        m_wake.notify_all();
+    }
+}
+
+std::size_t JobSystem::CurrentQueueIndex() const
+{
+    return (t_owner == this) ? t_workerIndex : m_workers.size();
+}
+} // namespace rg
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace rg
+{
+class JobSystem;
+
+// Completion counter for a set of jobs. Spawning a job on a counter increments
+// it and finishing the job decrements it; JobSystem::Wait returns once it is back
+// at zero. A job may spawn children on its own counter (the parent's wait then
+// covers them) or on a new counter it waits for itself.
+class JobCounter
+{
+public:
+    JobCounter() = default;
+    JobCounter(const JobCounter&) = delete;
+    JobCounter& operator=(const JobCounter&) = delete;
+
+    [[nodiscard]] bool IsDone() const
+    {
+        return m_pending.load(std::memory_order_acquire) == 0;
+    }
+
+private:
+    friend class JobSystem;
+
+    std::atomic<std::uint32_t> m_pending {0};
+    std::atomic<bool> m_failed {false};
+    std::mutex m_errorMutex;
+    std::exception_ptr m_error;
+};
+
+// Work-stealing job scheduler shared by engine subsystems. Every worker owns a
+// deque: it pushes and pops its own jobs at the back (newest first, cache-warm)
+// while idle workers steal from the front of other deques (oldest first, usually
+// the largest pieces of work). Jobs spawned from threads that are not workers go
+// to a shared injection queue. Waiting threads run queued jobs instead of
+// blocking, so jobs can wait for their children without starving the pool.
+class JobSystem
+{
+public:
+    using Job = std::function<void()>;
+    using RangeFunc = std::function<void(std::size_t begin, std::size_t end)>;
+
+    explicit JobSystem(std::size_t workerCount);
+    ~JobSystem();
+
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    // Process-wide scheduler with one worker per hardware thread minus the caller.
+    [[nodiscard]] static JobSystem& Shared();
+
+    [[nodiscard]] std::size_t WorkerCount() const;
+
+    // Queues job and ties it to counter. Safe to call from any thread, including
+    // from inside a running job.
+    void Spawn(JobCounter& counter, Job job);
+
+    // Runs queued jobs on the calling thread until counter reaches zero, then
+    // rethrows the first exception thrown by one of its jobs.
+    void Wait(JobCounter& counter);
+
+    // Runs one queued job on the calling thread, if there is one. Lets a thread
+    // that waits on something other than a JobCounter help in the meantime.
+    bool RunPendingJob();
+    // Same, but only picks a job tied to counter, so the caller does not end up
+    // running unrelated long work (e.g. streaming) while it waits for its own.
+    bool RunPendingJob(const JobCounter& counter);
+
+    // Splits [0, count) into chunks of at least minChunk items and runs them as
+    // jobs, the calling thread included. Blocks until every chunk is done; the first
+    // exception thrown by a chunk is rethrown on the caller. May be nested.
+    void ParallelFor(std::size_t count, std::size_t minChunk, const RangeFunc& func);
+
+private:
+    struct Task
+    {
+        Job job;
+        JobCounter* counter = nullptr;
+    };
+
+    struct Queue;
+
+    void WorkerLoop(std::size_t index);
+    // With a counter, only jobs tied to it are taken.
+    [[nodiscard]] bool TryRunOne(std::size_t selfIndex, const JobCounter* counter = nullptr);
+    [[nodiscard]] bool TryTake(std::size_t selfIndex, Task& task, const JobCounter* counter);
+    void Execute(Task& task);
+    [[nodiscard]] std::size_t CurrentQueueIndex() const;
+
+    std::vector<std::thread> m_workers;
+    // One deque per worker plus the injection queue at index WorkerCount().
+    std::vector<std::unique_ptr<Queue>> m_queues;
+    std::atomic<std::size_t> m_queuedTasks {0};
+    std::atomic<std::size_t> m_sleepers {0};
+    std::atomic<bool> m_stopping {false};
+    std::mutex m_sleepMutex;
+    std::condition_variable m_wake;
+};
+} // namespace rg
@@ -1,15 +1,32 @@
 #include "Engine/Core/Log.h"
 
+#include <atomic>
 #include <chrono>
+#include <condition_variable>
+#include <cstdint>
 #include <ctime>
-#include <iomanip>
+#include <fstream>
 #include <iostream>
-#include <sstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
 
 namespace rg
 {
 namespace
 {
+using Clock = std::chrono::system_clock;
+
+// Messages that fit the ring before producers start dropping.
+constexpr std::uint64_t kQueueCapacity = 4096;
+constexpr auto kIdleSleep = std::chrono::milliseconds(2);
+// A producer that finds the ring full wakes the drain thread and yields this many
+// times before it gives up and drops the message.
+constexpr int kFullRetries = 256;
+// How often a run of identical messages is summarized while it continues.
+constexpr auto kRepeatSummaryInterval = std::chrono::seconds(1);
+
 const char* ToString(const LogLevel level)
 {
     switch (level)
@@ -24,25 +41,328 @@ const char* ToString(const LogLevel level)
         return "LOG";
     }
 }
-} // namespace
 
-void Log::Write(const LogLevel level, const std::string& message)
+// Bounded multi-producer queue (Vyukov): every slot carries a sequence number
+// that tells producers whether it is free for their ticket and the consumer
+// whether it has been published, so neither side takes a lock.
+class LogQueue
 {
-    const auto now = std::chrono::system_clock::now();
-    const std::time_t time = std::chrono::system_clock::to_time_t(now);
+public:
+    struct Slot
+    {
+        std::atomic<std::uint64_t> sequence {0};
+        LogLevel level = LogLevel::Info;
+        Clock::time_point time;
+        // Keeps its capacity across reuse, so steady-state writes do not allocate.
+        std::string text;
+    };
+
+    LogQueue() : m_slots(std::make_unique<Slot[]>(kQueueCapacity))
+    {
+        for (std::uint64_t index = 0; index < kQueueCapacity; ++index)
+        {
+            m_slots[index].sequence.store(index, std::memory_order_relaxed);
+        }
+    }
+
+    // Returns the number of messages queued ahead of this one, or -1 when full.
+    long long TryPush(const LogLevel level, const std::string_view message)
+    {
+        std::uint64_t ticket = m_head.load(std::memory_order_relaxed);
+        Slot* slot = nullptr;
+        while (true)
+        {
+            slot = &m_slots[ticket % kQueueCapacity];
+            const std::uint64_t sequence = slot->sequence.load(std::memory_order_acquire);
+            if (sequence == ticket)
+            {
+                if (m_head.compare_exchange_weak(ticket, ticket + 1U, std::memory_order_relaxed))
+                {
+                    break;
+                }
+            }
+            else if (sequence < ticket)
+            {
+                return -1;
+            }
+            else
+            {
+                ticket = m_head.load(std::memory_order_relaxed);
+            }
+        }
+
+        slot->level = level;
+        slot->time = Clock::now();
+        slot->text.assign(message);
+        slot->sequence.store(ticket + 1U, std::memory_order_release);
+        return static_cast<long long>(ticket - Consumed());
+    }
 
-    std::tm localTime {};
+    // Single consumer: returns the next published slot or nullptr.
+    Slot* Front()
+    {
+        Slot& slot = m_slots[m_tail % kQueueCapacity];
+        return (slot.sequence.load(std::memory_order_acquire) == m_tail + 1U) ? &slot : nullptr;
+    }
+
+    void Pop()
+    {
+        m_slots[m_tail % kQueueCapacity].sequence.store(m_tail + kQueueCapacity, std::memory_order_release);
+        ++m_tail;
+        m_consumed.store(m_tail, std::memory_order_release);
+    }
+
+    [[nodiscard]] std::uint64_t Produced() const
+    {
+        return m_head.load(std::memory_order_acquire);
+    }
+
+    [[nodiscard]] std::uint64_t Consumed() const
+    {
+        return m_consumed.load(std::memory_order_acquire);
+    }
+
+private:
+    std::unique_ptr<Slot[]> m_slots;
+    alignas(64) std::atomic<std::uint64_t> m_head {0};
+    alignas(64) std::uint64_t m_tail = 0;
+    std::atomic<std::uint64_t> m_consumed {0};
+};
+
+class Logger
+{
+public:
+    Logger() : m_thread([this]()
+    {
+        DrainLoop();
+    })
+    {
+    }
+
+    ~Logger()
+    {
+        m_stop.store(true, std::memory_order_release);
+        m_thread.join();
+    }
+
+    Logger(const Logger&) = delete;
+    Logger& operator=(const Logger&) = delete;
+
+    void Write(const LogLevel level, const std::string_view message)
+    {
+        for (int attempt = 0; attempt <= kFullRetries; ++attempt)
+        {
+            const long long backlog = m_queue.TryPush(level, message);
+            if (backlog >= 0)
+            {
+                // Wake the drain thread early once the ring is half full instead of
+                // waiting out its idle sleep.
+                if (backlog == static_cast<long long>(kQueueCapacity / 2U))
+                {
+                    m_wake.notify_one();
+                }
+                return;
+            }
+            m_wake.notify_one();
+            std::this_thread::yield();
+        }
+        m_dropped.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void Flush()
+    {
+        // Messages pushed before this point have tickets below target.
+        const std::uint64_t target = m_queue.Produced();
+        while (m_queue.Consumed() < target)
+        {
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+        }
+        std::lock_guard<std::mutex> lock(m_sinkMutex);
+        std::cout.flush();
+        if (m_file.is_open())
+        {
+            m_file.flush();
+        }
+    }
+
+    bool OpenFile(const std::filesystem::path& path)
+    {
+        std::lock_guard<std::mutex> lock(m_sinkMutex);
+        m_file.close();
+        m_file.clear();
+        m_file.open(path, std::ios::trunc);
+        return m_file.is_open();
+    }
+
+    void CloseFile()
+    {
+        std::lock_guard<std::mutex> lock(m_sinkMutex);
+        m_file.close();
+    }
+
+private:
+    void DrainLoop()
+    {
+        while (true)
+        {
+            // Read the flag first so a message pushed right before Stop is still seen.
+            const bool stopping = m_stop.load(std::memory_order_acquire);
+            bool wrote = false;
+            {
+                std::lock_guard<std::mutex> lock(m_sinkMutex);
+                while (LogQueue::Slot* slot = m_queue.Front())
+                {
+                    Consume(slot->level, slot->time, slot->text);
+                    m_queue.Pop();
+                    wrote = true;
+                }
+                ReportRepeats(false);
+                ReportDropped();
+                if (wrote)
+                {
+                    std::cout.flush();
+                    if (m_file.is_open())
+                    {
+                        m_file.flush();
+                    }
+                }
+            }
+
+            if (stopping)
+            {
+                std::lock_guard<std::mutex> lock(m_sinkMutex);
+                ReportRepeats(true);
+                std::cout.flush();
+                return;
+            }
+            if (!wrote)
+            {
+                std::unique_lock<std::mutex> lock(m_wakeMutex);
+                m_wake.wait_for(lock, kIdleSleep);
+            }
+        }
+    }
+
+    void Consume(const LogLevel level, const Clock::time_point time, const std::string& text)
+    {
+        if ((m_repeatCount >= 0) && (level == m_lastLevel) && (text == m_lastText))
+        {
+            ++m_repeatCount;
+            m_lastTime = time;
+            return;
+        }
+
+        ReportRepeats(true);
+        Emit(level, time, text);
+        m_lastLevel = level;
+        m_lastText = text;
+        m_lastTime = time;
+        m_repeatCount = 0;
+        m_repeatReported = time;
+    }
+
+    // A run of duplicates is summarized when it ends, and once per interval while
+    // it goes on.
+    void ReportRepeats(const bool runEnded)
+    {
+        if (m_repeatCount <= 0)
+        {
+            return;
+        }
+        if (!runEnded && ((m_lastTime - m_repeatReported) < kRepeatSummaryInterval))
+        {
+            return;
+        }
+
+        Emit(m_lastLevel, m_lastTime, "(previous message repeated " + std::to_string(m_repeatCount) + " times)");
+        m_repeatCount = 0;
+        m_repeatReported = m_lastTime;
+    }
+
+    void ReportDropped()
+    {
+        const std::uint64_t dropped = m_dropped.exchange(0, std::memory_order_relaxed);
+        if (dropped > 0)
+        {
+            ReportRepeats(true);
+            m_repeatCount = -1;
+            Emit(LogLevel::Warning, Clock::now(), "Log queue full: " + std::to_string(dropped) + " messages dropped.");
+        }
+    }
+
+    void Emit(const LogLevel level, const Clock::time_point time, const std::string_view text)
+    {
+        const std::time_t seconds = Clock::to_time_t(time);
+        if (seconds != m_stampSeconds)
+        {
+            std::tm localTime {};
 #if defined(_WIN32)
-    localtime_s(&localTime, &time);
+            localtime_s(&localTime, &seconds);
 #else
-    localtime_r(&time, &localTime);
+            localtime_r(&seconds, &localTime);
 #endif
+            std::strftime(m_stamp, sizeof(m_stamp), "%H:%M:%S", &localTime);
+            m_stampSeconds = seconds;
+        }
 
-    std::ostringstream oss;
-    oss << "[" << std::put_time(&localTime, "%H:%M:%S") << "] "
-        << "[" << ToString(level) << "] "
-        << message;
+        std::cout << '[' << m_stamp << "] [" << ToString(level) << "] " << text << '\n';
+        if (m_file.is_open())
+        {
+            m_file << '[' << m_stamp << "] [" << ToString(level) << "] " << text << '\n';
+        }
+    }
+
+    LogQueue m_queue;
+    std::atomic<std::uint64_t> m_dropped {0};
+    std::atomic<bool> m_stop {false};
+    // Producers notify without taking the mutex; a missed wake-up only costs one
+    // idle interval.
+    std::mutex m_wakeMutex;
+    std::condition_variable m_wake;
+
+    // Sinks and drain-side state; the mutex only serializes the drain thread with
+    // OpenFile/CloseFile/Flush, never with Write.
+    std::mutex m_sinkMutex;
+    std::ofstream m_file;
+    LogLevel m_lastLevel = LogLevel::Info;
+    std::string m_lastText;
+    Clock::time_point m_lastTime;
+    Clock::time_point m_repeatReported;
+    // -1 means there is no previous message to compare against.
+    long long m_repeatCount = -1;
+    std::time_t m_stampSeconds = -1;
+    char m_stamp[16] = {};
+
+    std::thread m_thread;
+};
+
+Logger& Instance()
+{
+    static Logger logger;
+    return logger;
+}
+} // namespace
+
+void Log::Write(const LogLevel level, const std::string_view message)
+{
+    if (IsEnabled(level))
+    {
+        Instance().Write(level, message);
+    }
+}
+
+void Log::Flush()
+{
+    Instance().Flush();
+}
 
-    std::cout << oss.str() << '\n';
+bool Log::OpenFile(const std::filesystem::path& path)
+{
+    return Instance().OpenFile(path);
+}
+
+void Log::CloseFile()
+{
+    Instance().CloseFile();
 }
 } // namespace rg
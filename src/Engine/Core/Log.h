@@ -1,6 +1,13 @@
 #pragma once
 
-#include <string>
+#include <filesystem>
+#include <string_view>
+
+// Messages below this level are compiled out of RG_LOG and dropped by Log::Write:
+// 0 = Info, 1 = Warning, 2 = Error.
+#if !defined(RG_LOG_MIN_LEVEL)
+#define RG_LOG_MIN_LEVEL 0
+#endif
 
 namespace rg
 {
@@ -11,9 +18,38 @@ enum class LogLevel
     Error
 };
 
+// Asynchronous logger. Write() copies the message into a lock-free ring buffer
+// and returns; a background thread timestamps, formats and writes it to the
+// console and the optional log file. Consecutive identical messages are collapsed
+// into a periodic "repeated N times" line. When the ring is full, messages are
+// dropped and counted rather than blocking the caller.
 class Log
 {
 public:
-    static void Write(LogLevel level, const std::string& message);
+    [[nodiscard]] static constexpr bool IsEnabled(const LogLevel level)
+    {
+        return static_cast<int>(level) >= RG_LOG_MIN_LEVEL;
+    }
+
+    // Safe to call from any thread.
+    static void Write(LogLevel level, std::string_view message);
+
+    // Blocks until every message written before the call has been output.
+    static void Flush();
+
+    // Mirrors output to a file (truncated on open) in addition to the console.
+    static bool OpenFile(const std::filesystem::path& path);
+    static void CloseFile();
 };
 } // namespace rg
+
+// Like Log::Write, but the message expression is not evaluated at all when the
+// level is compiled out. Use it where building the message costs something.
+#define RG_LOG(level, message)                      \
+    do                                              \
+    {                                               \
+        if constexpr (::rg::Log::IsEnabled(level))  \
+        {                                           \
+            ::rg::Log::Write(level, message);       \
+        }                                           \
+    } while (false)
@@ -0,0 +1,174 @@
+#include "Engine/Core/Profiler.h"
+
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace rg
+{
+namespace
+{
+struct ProfileEvent
+{
+    const char* name = nullptr;
+    std::uint64_t startNs = 0;
+    std::uint64_t endNs = 0;
+};
+
+struct ThreadBuffer
+{
+    std::uint32_t threadId = 0;
+    std::string threadName;
+    // Total zones ever written; the ring holds the last kEventsPerThread of them.
+    std::atomic<std::uint64_t> written {0};
+    std::unique_ptr<ProfileEvent[]> events = std::make_unique<ProfileEvent[]>(Profiler::kEventsPerThread);
+};
+
+struct BufferRegistry
+{
+    std::mutex mutex;
+    // Buffers stay alive after their thread exits so late exports still see them.
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+};
+
+BufferRegistry& Buffers()
+{
+    static BufferRegistry registry;
+    return registry;
+}
+
+ThreadBuffer& LocalBuffer()
+{
+    thread_local ThreadBuffer* buffer = nullptr;
+    if (buffer == nullptr)
+    {
+        auto created = std::make_shared<ThreadBuffer>();
+        BufferRegistry& registry = Buffers();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        created->threadId = static_cast<std::uint32_t>(registry.buffers.size()) + 1U;
+        buffer = created.get();
+        registry.buffers.push_back(std::move(created));
+    }
+    return *buffer;
+}
+
+void WriteJsonString(std::ofstream& file, const char* text)
+{
+    file << '"';
+    for (const char* c = text; *c != '\0'; ++c)
+    {
+        const auto code = static_cast<unsigned char>(*c);
+        if ((*c == '"') || (*c == '\\'))
+        {
+            file << '\\' << *c;
+        }
+        else if (code < 0x20U)
+        {
+            char escaped[8];
+            std::snprintf(escaped, sizeof(escaped), "\\u%04x", code);
+            file << escaped;
+        }
+        else
+        {
+            file << *c;
+        }
+    }
+    file << '"';
+}
+
+void WriteMicroseconds(std::ofstream& file, const std::uint64_t nanoseconds)
+{
+    char text[32];
+    std::snprintf(text, sizeof(text), "%.3f", static_cast<double>(nanoseconds) / 1000.0);
+    file << text;
+}
+} // namespace
+
+std::atomic<bool> Profiler::s_enabled {true};
+const std::chrono::steady_clock::time_point Profiler::s_epoch = std::chrono::steady_clock::now();
+
+void Profiler::SetEnabled(const bool enabled)
+{
+    s_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+void Profiler::Record(const char* name, const std::uint64_t startNs, const std::uint64_t endNs)
+{
+    ThreadBuffer& buffer = LocalBuffer();
+    const std::uint64_t index = buffer.written.load(std::memory_order_relaxed);
+    buffer.events[index % kEventsPerThread] = ProfileEvent {name, startNs, endNs};
+    buffer.written.store(index + 1U, std::memory_order_release);
+}
+
+void Profiler::SetThreadName(const char* name)
+{
+    ThreadBuffer& buffer = LocalBuffer();
+    std::lock_guard<std::mutex> lock(Buffers().mutex);
+    buffer.threadName = name;
+}
+
+void Profiler::Clear()
+{
+    BufferRegistry& registry = Buffers();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    for (const auto& buffer : registry.buffers)
+    {
+        buffer->written.store(0, std::memory_order_relaxed);
+    }
+}
+
+bool Profiler::WriteChromeTrace(const std::filesystem::path& path)
+{
+    std::ofstream file(path, std::ios::trunc);
+    if (!file)
+    {
+        return false;
+    }
+
+    BufferRegistry& registry = Buffers();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+
+    file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    bool first = true;
+    const auto separator = [&file, &first]()
+    {
+        if (!first)
+        {
+            file << ",\n";
+        }
+        first = false;
+    };
+
+    for (const auto& buffer : registry.buffers)
+    {
+        if (!buffer->threadName.empty())
+        {
+            separator();
+            file << "{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,\"tid\":" << buffer->threadId << ",\"args\":{\"name\":";
+            WriteJsonString(file, buffer->threadName.c_str());
+            file << "}}";
+        }
+
+        const std::uint64_t written = buffer->written.load(std::memory_order_acquire);
+        const std::uint64_t begin = (written > kEventsPerThread) ? written - kEventsPerThread : 0U;
+        for (std::uint64_t index = begin; index < written; ++index)
+        {
+            const ProfileEvent& event = buffer->events[index % kEventsPerThread];
+            separator();
+            file << "{\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->threadId << ",\"name\":";
+            WriteJsonString(file, event.name);
+            file << ",\"ts\":";
+            WriteMicroseconds(file, event.startNs);
+            file << ",\"dur\":";
+            WriteMicroseconds(file, event.endNs - event.startNs);
+            file << '}';
+        }
+    }
+
+    file << "]}\n";
+    return static_cast<bool>(file);
+}
+} // namespace rg
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+
+// Profiler zones compile to nothing when RG_ENABLE_PROFILER is 0.
+#if !defined(RG_ENABLE_PROFILER)
+#define RG_ENABLE_PROFILER 1
+#endif
+
+namespace rg
+{
+// Scoped CPU zone profiler. Every thread records finished zones into its own
+// fixed-size ring buffer, so recording takes no locks and the oldest zones are
+// overwritten once a buffer is full. Captures export to the Chrome trace-event
+// JSON format (chrome://tracing, Perfetto).
+class Profiler
+{
+public:
+    // Zones kept per thread before the oldest are overwritten.
+    static constexpr std::size_t kEventsPerThread = 1U << 16U;
+
+    static void SetEnabled(bool enabled);
+    [[nodiscard]] static bool IsEnabled()
+    {
+        return s_enabled.load(std::memory_order_relaxed);
+    }
+
+    // Nanoseconds since the profiler epoch.
+    [[nodiscard]] static std::uint64_t Now()
+    {
+        return static_cast<std::uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - s_epoch).count());
+    }
+
+    // name must outlive the capture (string literals, ISystem::Name()).
+    static void Record(const char* name, std::uint64_t startNs, std::uint64_t endNs);
+
+    // Label for the calling thread in exported traces.
+    static void SetThreadName(const char* name);
+
+    // Drops every recorded zone.
+    static void Clear();
+
+    // Writes all buffered zones as Chrome trace-event JSON. Call while no zones are
+    // being recorded, e.g. between frames or after the loop has ended.
+    static bool WriteChromeTrace(const std::filesystem::path& path);
+
+private:
+    static std::atomic<bool> s_enabled;
+    static const std::chrono::steady_clock::time_point s_epoch;
+};
+
+class ProfileZone
+{
+public:
+    explicit ProfileZone(const char* name) : m_name(Profiler::IsEnabled() ? name : nullptr)
+    {
+        if (m_name != nullptr)
+        {
+            m_startNs = Profiler::Now();
+        }
+    }
+
+    ~ProfileZone()
+    {
+        if (m_name != nullptr)
+        {
+            Profiler::Record(m_name, m_startNs, Profiler::Now());
+        }
+    }
+
+    ProfileZone(const ProfileZone&) = delete;
+    ProfileZone& operator=(const ProfileZone&) = delete;
+
+private:
+    const char* m_name = nullptr;
+    std::uint64_t m_startNs = 0;
+};
+} // namespace rg
+
+#define RG_PROFILE_CONCAT_INNER(a, b) a##b
+#define RG_PROFILE_CONCAT(a, b) RG_PROFILE_CONCAT_INNER(a, b)
+
+#if RG_ENABLE_PROFILER
+#define RG_PROFILE_SCOPE(name) const ::rg::ProfileZone RG_PROFILE_CONCAT(rgProfileZone, __LINE__)(name)
+#else
+#define RG_PROFILE_SCOPE(name) static_cast<void>(0)
+#endif
@@ -0,0 +1,272 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "Engine/ECS/ComponentType.h"
+#include "Engine/ECS/EntityId.h"
+#include "Engine/ECS/Registry.h"
+
+namespace rg::ecs
+{
+// Entity created through a CommandBuffer; it gets a real id at playback.
+struct PendingEntity
+{
+    std::uint32_t index = 0;
+};
+
+// Records structural registry changes so they can be issued from inside
+// iteration or from worker threads, then applied at a sync point with Playback().
+// Recording is thread-safe; Playback must not run concurrently with recording.
+//
+// Playback order: pending entities are created first, then component commands
+// run grouped by component type and target entity (commands on the same
+// component of the same entity keep their recorded order), destroys run last.
+// Commands that target an entity which is no longer alive are skipped.
+//
+// Added components are moved into per-type storage that keeps its capacity
+// between playbacks, so recording an add does not allocate once the buffer has
+// warmed up, and move-only components can be recorded.
+class CommandBuffer
+{
+public:
+    PendingEntity CreateEntity()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return PendingEntity {m_pendingCount++};
+    }
+
+    void DestroyEntity(const EntityId id)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_destroys.push_back(id);
+    }
+
+    template <typename Component, typename... Args>
+    void AddComponent(const EntityId id, Args&&... args)
+    {
+        RecordAdd<Component>(Target {id, false}, std::forward<Args>(args)...);
+    }
+
+    template <typename Component, typename... Args>
+    void AddComponent(const PendingEntity entity, Args&&... args)
+    {
+        RecordAdd<Component>(Target {entity.index, true}, std::forward<Args>(args)...);
+    }
+
+    template <typename Component>
+    void RemoveComponent(const EntityId id)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        const std::uint32_t slot = MutablePayloads<Component>().Push(std::nullopt);
+        m_commands.push_back(Command {Target {id, false}, ComponentTypeId<Component>(), m_nextSequence++, slot});
+    }
+
+    [[nodiscard]] bool Empty() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return (m_pendingCount == 0) && m_commands.empty() && m_destroys.empty();
+    }
+
+    // Applies and clears every recorded command. Returns the ids of the pending
+    // entities, indexed by PendingEntity::index.
+    std::vector<EntityId> Playback(Registry& registry)
+    {
+        std::uint32_t pendingCount = 0;
+        std::vector<Command> commands;
+        std::vector<EntityId> destroys;
+        std::vector<std::unique_ptr<IPayloadStore>> payloads;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            pendingCount = m_pendingCount;
+            commands.swap(m_commands);
+            destroys.swap(m_destroys);
+            payloads.swap(m_payloads);
+            m_pendingCount = 0;
+        }
+
+        std::vector<EntityId> created;
+        created.reserve(pendingCount);
+        for (std::uint32_t i = 0; i < pendingCount; ++i)
+        {
+            created.push_back(registry.CreateEntity());
+        }
+
+        for (Command& command : commands)
+        {
+            if (command.target.pending)
+            {
+                command.target = Target {created[command.target.value], false};
+            }
+        }
+
+        std::sort(commands.begin(), commands.end(), [](const Command& a, const Command& b)
+        {
+            if (a.componentType != b.componentType)
+            {
+                return a.componentType < b.componentType;
+            }
+            if (EntityIndex(a.target.value) != EntityIndex(b.target.value))
+            {
+                return EntityIndex(a.target.value) < EntityIndex(b.target.value);
+            }
+            return a.sequence < b.sequence;
+        });
+
+        for (Command& command : commands)
+        {
+            if (registry.IsAlive(command.target.value))
+            {
+                payloads[command.componentType]->Apply(registry, command.target.value, command.slot);
+            }
+        }
+
+        std::sort(destroys.begin(), destroys.end());
+        destroys.erase(std::unique(destroys.begin(), destroys.end()), destroys.end());
+        for (const EntityId id : destroys)
+        {
+            registry.DestroyEntity(id);
+        }
+
+        // Hand the emptied storage back for reuse unless commands were recorded
+        // into fresh storage meanwhile.
+        commands.clear();
+        destroys.clear();
+        for (auto& store : payloads)
+        {
+            if (store != nullptr)
+            {
+                store->Clear();
+            }
+        }
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_commands.empty() && m_payloads.empty())
+            {
+                m_commands.swap(commands);
+                m_payloads.swap(payloads);
+            }
+            if (m_destroys.empty())
+            {
+                m_destroys.swap(destroys);
+            }
+        }
+
+        return created;
+    }
+
+    void Clear()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_pendingCount = 0;
+        m_commands.clear();
+        m_destroys.clear();
+        for (auto& store : m_payloads)
+        {
+            if (store != nullptr)
+            {
+                store->Clear();
+            }
+        }
+    }
+
+private:
+    struct Target
+    {
+        std::uint32_t value = 0;
+        bool pending = false;
+    };
+
+    // A command's payload lives in the store of its component type, at slot.
+    struct Command
+    {
+        Target target;
+        std::size_t componentType = 0;
+        std::uint64_t sequence = 0;
+        std::uint32_t slot = 0;
+    };
+
+    class IPayloadStore
+    {
+    public:
+        virtual ~IPayloadStore() = default;
+
+        virtual void Apply(Registry& registry, EntityId entity, std::uint32_t slot) = 0;
+        virtual void Clear() = 0;
+    };
+
+    // Recorded adds of one component type; an empty slot records a remove.
+    template <typename Component>
+    class PayloadStore final : public IPayloadStore
+    {
+    public:
+        std::uint32_t Push(std::optional<Component> value)
+        {
+            m_values.push_back(std::move(value));
+            return static_cast<std::uint32_t>(m_values.size() - 1);
+        }
+
+        void Apply(Registry& registry, const EntityId entity, const std::uint32_t slot) override
+        {
+            std::optional<Component>& value = m_values[slot];
+            if (value.has_value())
+            {
+                registry.AddComponent<Component>(entity, std::move(*value));
+            }
+            else
+            {
+                registry.RemoveComponent<Component>(entity);
+            }
+        }
+
+        void Clear() override
+        {
+            m_values.clear();
+        }
+
+    private:
+        std::vector<std::optional<Component>> m_values;
+    };
+
+    template <typename Component, typename... Args>
+    void RecordAdd(const Target target, Args&&... args)
+    {
+        // Construct outside the lock; only the move into storage is serialized.
+        std::optional<Component> value(std::in_place, std::forward<Args>(args)...);
+        std::lock_guard<std::mutex> lock(m_mutex);
+        const std::uint32_t slot = MutablePayloads<Component>().Push(std::move(value));
+        m_commands.push_back(Command {target, ComponentTypeId<Component>(), m_nextSequence++, slot});
+    }
+
+    // Callers hold m_mutex.
+    template <typename Component>
+    PayloadStore<Component>& MutablePayloads()
+    {
+        const std::size_t type = ComponentTypeId<Component>();
+        if (type >= m_payloads.size())
+        {
+            m_payloads.resize(type + 1);
+        }
+
+        auto& store = m_payloads[type];
+        if (store == nullptr)
+        {
+            store = std::make_unique<PayloadStore<Component>>();
+        }
+        return static_cast<PayloadStore<Component>&>(*store);
+    }
+
+    mutable std::mutex m_mutex;
+    std::uint32_t m_pendingCount = 0;
+    std::uint64_t m_nextSequence = 0;
+    std::vector<Command> m_commands;
+    std::vector<std::unique_ptr<IPayloadStore>> m_payloads;
+    std::vector<EntityId> m_destroys;
+};
+} // namespace rg::ecs
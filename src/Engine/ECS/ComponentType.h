@@ -0,0 +1,34 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <type_traits>
+
+namespace rg::ecs
+{
+namespace detail
+{
+inline std::size_t NextComponentTypeId()
+{
+    static std::atomic<std::size_t> next {0};
+    return next.fetch_add(1);
+}
+} // namespace detail
+
+// Small dense id per component type, assigned from a process-wide counter the
+// first time the type is used. The registry indexes its pool table with it, so a
+// pool lookup is an array access instead of hashing std::type_info.
+template <typename Component>
+[[nodiscard]] std::size_t ComponentTypeId()
+{
+    if constexpr (std::is_const_v<Component> || std::is_volatile_v<Component>)
+    {
+        return ComponentTypeId<std::remove_cv_t<Component>>();
+    }
+    else
+    {
+        static const std::size_t id = detail::NextComponentTypeId();
+        return id;
+    }
+}
+} // namespace rg::ecs
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstdint>
+
+namespace rg::ecs
+{
+// Entity handle: low bits are a slot index, high bits a version that is bumped
+// every time the slot is recycled, so stale handles never compare equal to the
+// entity that reuses their slot. Index 0 is reserved for InvalidEntity.
+using EntityId = std::uint32_t;
+constexpr EntityId InvalidEntity = 0;
+
+constexpr std::uint32_t kEntityIndexBits = 22;
+constexpr std::uint32_t kEntityIndexMask = (1U << kEntityIndexBits) - 1U;
+constexpr std::uint32_t kEntityVersionMask = (1U << (32U - kEntityIndexBits)) - 1U;
+
+[[nodiscard]] constexpr std::uint32_t EntityIndex(const EntityId id)
+{
+    return id & kEntityIndexMask;
+}
+
+[[nodiscard]] constexpr std::uint32_t EntityVersion(const EntityId id)
+{
+    return id >> kEntityIndexBits;
+}
+
+[[nodiscard]] constexpr EntityId MakeEntityId(const std::uint32_t index, const std::uint32_t version)
+{
+    return ((version & kEntityVersionMask) << kEntityIndexBits) | (index & kEntityIndexMask);
+}
+} // namespace rg::ecs
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <cstddef>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+
+#include "Engine/Core/JobSystem.h"
+#include "Engine/ECS/EntityId.h"
+#include "Engine/ECS/SparseSet.h"
+
+namespace rg::ecs
+{
+// Owning group: takes ownership of the packed order of every pool it names and
+// keeps the entities that have all of them at the front of each pool, in the same
+// order. Iteration is then a lockstep walk over [0, Size()) of every pool with no
+// sparse lookups. A pool can be owned by only one group.
+template <typename... Owned>
+class OwningGroup final : public IPoolObserver
+{
+public:
+    static_assert(sizeof...(Owned) >= 2, "An owning group needs at least two component types.");
+    static_assert((!std::is_empty_v<Owned> && ...), "Tag components cannot be owned by a group.");
+
+    explicit OwningGroup(ComponentPool<Owned>*... pools) : m_pools(pools...)
+    {
+        const bool alreadyOwned = ((pools->Owner() != nullptr) || ...);
+        if (alreadyOwned)
+        {
+            throw std::runtime_error("Component pool is already owned by another group.");
+        }
+        (pools->SetOwner(this), ...);
+
+        const SparseSet& first = *std::get<0>(m_pools);
+        for (std::size_t index = 0; index < first.Size(); ++index)
+        {
+            OnInsert(first.Entities()[index]);
+        }
+    }
+
+    OwningGroup(const OwningGroup&) = delete;
+    OwningGroup& operator=(const OwningGroup&) = delete;
+
+    [[nodiscard]] std::size_t Size() const
+    {
+        return m_size;
+    }
+
+    [[nodiscard]] bool Contains(const EntityId id) const
+    {
+        const SparseSet& first = *std::get<0>(m_pools);
+        return first.Contains(id) && (first.IndexOf(id) < m_size);
+    }
+
+    // The callback may modify component values but must not add or remove
+    // components of the owned types while the group is being walked.
+    template <typename Func>
+    void Each(Func&& func) const
+    {
+        const auto& entities = std::get<0>(m_pools)->Entities();
+        for (std::size_t index = 0; index < m_size; ++index)
+        {
+            func(entities[index], std::get<ComponentPool<Owned>*>(m_pools)->At(index)...);
+        }
+    }
+
+    // Same as Each() but runs batches of the group range on the shared worker
+    // pool. The callback runs concurrently and must be thread-safe.
+    template <typename Func>
+    void ParallelEach(Func&& func, const std::size_t minBatch) const
+    {
+        const auto& entities = std::get<0>(m_pools)->Entities();
+        JobSystem::Shared().ParallelFor(m_size, minBatch, [&](const std::size_t begin, const std::size_t end)
+        {
+            for (std::size_t index = begin; index < end; ++index)
+            {
+                func(entities[index], std::get<ComponentPool<Owned>*>(m_pools)->At(index)...);
+            }
+        });
+    }
+
+    void OnInsert(const EntityId id) override
+    {
+        if (Contains(id) || !(std::get<ComponentPool<Owned>*>(m_pools)->Contains(id) && ...))
+        {
+            return;
+        }
+
+        (SwapInto<Owned>(id, m_size), ...);
+        ++m_size;
+    }
+
+    void OnErase(const EntityId id) override
+    {
+        if (!Contains(id))
+        {
+            return;
+        }
+
+        --m_size;
+        (SwapInto<Owned>(id, m_size), ...);
+    }
+
+private:
+    template <typename Component>
+    void SwapInto(const EntityId id, const std::size_t position)
+    {
+        auto* pool = std::get<ComponentPool<Component>*>(m_pools);
+        pool->SwapAt(pool->IndexOf(id), position);
+    }
+
+    std::tuple<ComponentPool<Owned>*...> m_pools;
+    std::size_t m_size = 0;
+};
+} // namespace rg::ecs
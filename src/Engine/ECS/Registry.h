@@ -1,48 +1,99 @@
 #pragma once
 
 #include <algorithm>
+#include <atomic>
+#include <cstddef>
 #include <cstdint>
 #include <memory>
+#include <optional>
 #include <stdexcept>
-#include <typeindex>
-#include <unordered_map>
-#include <unordered_set>
+#include <tuple>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
+#include "Engine/ECS/ComponentType.h"
+#include "Engine/ECS/EntityId.h"
+#include "Engine/ECS/Group.h"
+#include "Engine/ECS/SparseSet.h"
+#include "Engine/ECS/TagPool.h"
+#include "Engine/ECS/View.h"
+
 namespace rg::ecs
 {
-using EntityId = std::uint32_t;
-constexpr EntityId InvalidEntity = 0;
-
 class Registry
 {
 public:
+    static constexpr std::size_t kDefaultParallelBatch = 1024;
+
+    // Recycles a destroyed slot when one is free; the slot version was already
+    // bumped on destroy, so handles to the previous occupant stay invalid.
     EntityId CreateEntity()
     {
-        const EntityId id = m_nextId++;
-        m_alive.insert(id);
-        m_entities.push_back(id);
-        return id;
+        RequireNoParallelIteration();
+        RequireIndexSpace(1);
+        return AllocateEntity();
+    }
+
+    // Creates count entities at once and gives each of them a copy of every
+    // prototype component. Entity and pool storage is reserved once and the
+    // components are appended in bulk, which is much cheaper than count calls to
+    // CreateEntity plus AddComponent. Returns the new ids in creation order.
+    template <typename... Components>
+    std::vector<EntityId> CreateEntities(const std::size_t count, const Components&... prototype)
+    {
+        RequireNoParallelIteration();
+        RequireIndexSpace(count);
+
+        const std::size_t appended = count - std::min(count, m_freeIndices.size());
+        m_slots.reserve(m_slots.size() + appended);
+        m_positions.reserve(m_positions.size() + appended);
+        m_entities.reserve(m_entities.size() + count);
+
+        std::vector<EntityId> ids;
+        ids.reserve(count);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            ids.push_back(AllocateEntity());
+        }
+
+        (MutableStore<Components>().InsertCopies(ids, prototype), ...);
+        return ids;
     }
 
     void DestroyEntity(const EntityId id)
     {
-        if (!m_alive.erase(id))
+        RequireNoParallelIteration();
+        if (!IsAlive(id))
         {
             return;
         }
 
-        m_entities.erase(std::remove(m_entities.begin(), m_entities.end(), id), m_entities.end());
-        for (auto& pair : m_componentStores)
+        for (auto& store : m_componentStores)
         {
-            pair.second->Remove(id);
+            if (store != nullptr)
+            {
+                store->RemoveEntity(id);
+            }
         }
+
+        const std::uint32_t index = EntityIndex(id);
+        const std::uint32_t position = m_positions[index];
+        const EntityId last = m_entities.back();
+        m_entities[position] = last;
+        m_positions[EntityIndex(last)] = position;
+        m_entities.pop_back();
+
+        m_positions[index] = kNoPosition;
+        m_slots[index] = MakeEntityId(index, EntityVersion(id) + 1U);
+        m_freeIndices.push_back(index);
     }
 
     [[nodiscard]] bool IsAlive(const EntityId id) const
     {
-        return m_alive.contains(id);
+        const std::uint32_t index = EntityIndex(id);
+        return (id != InvalidEntity) && (index < m_slots.size()) && (m_slots[index] == id) &&
+               (m_positions[index] != kNoPosition);
     }
 
     [[nodiscard]] std::size_t EntityCount() const
@@ -50,6 +101,8 @@ public:
         return m_entities.size();
     }
 
+    // Alive entities in no particular order: destroying an entity moves the last
+    // one into its place.
     [[nodiscard]] const std::vector<EntityId>& Entities() const
     {
         return m_entities;
@@ -59,38 +112,46 @@ public:
     Component& AddComponent(const EntityId id, Args&&... args)
     {
         RequireAlive(id);
-        auto& data = MutableStore<Component>().data;
-        auto [it, inserted] = data.try_emplace(id, std::forward<Args>(args)...);
-        if (!inserted)
-        {
-            it->second = Component(std::forward<Args>(args)...);
-        }
-        return it->second;
+        RequireNoParallelIteration();
+        return MutableStore<Component>().Emplace(id, std::forward<Args>(args)...);
     }
 
     template <typename Component>
     void RemoveComponent(const EntityId id)
     {
-        MutableStore<Component>().data.erase(id);
+        RequireNoParallelIteration();
+        // A stale handle must not clear the tag bit of the slot's new occupant.
+        if (std::is_empty_v<Component> && !IsAlive(id))
+        {
+            return;
+        }
+
+        if (auto* store = TryStore<Component>())
+        {
+            store->Remove(id);
+        }
     }
 
     template <typename Component>
     [[nodiscard]] bool HasComponent(const EntityId id) const
     {
+        // Tag bits are keyed by index only, so a stale handle needs the alive check.
         const auto* store = TryStore<Component>();
-        return (store != nullptr) && store->data.contains(id);
+        return (store != nullptr) && store->Contains(id) && (!std::is_empty_v<Component> || IsAlive(id));
     }
 
+    // Never creates a pool, so it is safe from concurrently scheduled systems.
     template <typename Component>
     Component& GetComponent(const EntityId id)
     {
-        auto& data = MutableStore<Component>().data;
-        const auto it = data.find(id);
-        if (it == data.end())
+        auto* store = TryStore<Component>();
+        if (store == nullptr)
         {
-            throw std::runtime_error("Component is missing on entity.");
+            throw std::runtime_error("Component store is missing.");
         }
-        return it->second;
+
+        RequireTagOwnerAlive<Component>(id);
+        return store->Get(id);
     }
 
     template <typename Component>
@@ -102,94 +163,266 @@ public:
             throw std::runtime_error("Component store is missing.");
         }
 
-        const auto it = store->data.find(id);
-        if (it == store->data.end())
-        {
-            throw std::runtime_error("Component is missing on entity.");
-        }
-        return it->second;
+        RequireTagOwnerAlive<Component>(id);
+        return store->Get(id);
     }
 
-    template <typename... Components, typename Func>
-    void ForEach(Func&& func)
+    // Change tracking: AddComponent marks the component as changed; writers mark
+    // further modifications with MarkChanged. MarkChanged may be called from a
+    // ParallelForEach callback for the entity being visited.
+    template <typename Component>
+    void MarkChanged(const EntityId id)
     {
-        for (const EntityId entity : m_entities)
+        if constexpr (!std::is_empty_v<Component>)
         {
-            if ((HasComponent<Components>(entity) && ...))
+            if (auto* store = TryStore<Component>())
             {
-                func(entity, GetComponent<Components>(entity)...);
+                store->MarkChanged(id);
             }
         }
     }
 
-    template <typename... Components, typename Func>
-    void ForEach(Func&& func) const
+    // Visits components marked changed after sinceVersion and returns the version
+    // to pass on the next call (start from 0). Removed components are not reported.
+    template <typename Component, typename Func>
+    std::uint64_t ForEachChanged(const std::uint64_t sinceVersion, Func&& func)
     {
-        for (const EntityId entity : m_entities)
+        static_assert(!std::is_empty_v<Component>, "Tag components carry no change stamps.");
+        auto* store = TryStore<Component>();
+        return (store != nullptr) ? store->ForEachChanged(sinceVersion, std::forward<Func>(func)) : sinceVersion;
+    }
+
+    // Notifies observer whenever Component is added to or removed from an entity,
+    // e.g. to keep a mirror of the pool in step with ForEachChanged. The observer
+    // must be removed before it is destroyed.
+    template <typename Component>
+    void AddObserver(IPoolObserver* observer)
+    {
+        static_assert(!std::is_empty_v<Component>, "Tag pools have no observers.");
+        RequireNoParallelIteration();
+        MutableStore<Component>().AddObserver(observer);
+    }
+
+    template <typename Component>
+    void RemoveObserver(IPoolObserver* observer)
+    {
+        static_assert(!std::is_empty_v<Component>, "Tag pools have no observers.");
+        RequireNoParallelIteration();
+        if (auto* store = TryStore<Component>())
         {
-            if ((HasComponent<Components>(entity) && ...))
-            {
-                func(entity, GetComponent<Components>(entity)...);
-            }
+            store->RemoveObserver(observer);
         }
     }
 
-private:
-    struct IStore
+    // Persistent view over the given query terms (see View.h). Pools are created
+    // if needed so the view stays valid for the lifetime of the registry.
+    template <typename... Terms>
+    [[nodiscard]] ComponentView<Terms...> View()
     {
-        virtual ~IStore() = default;
-        virtual void Remove(EntityId id) = 0;
-    };
+        return ComponentView<Terms...>(&MutableStore<TermComponent<Terms>>()...);
+    }
+
+    template <typename... Terms>
+    [[nodiscard]] ComponentView<ConstTerm<Terms>...> View() const
+    {
+        return ComponentView<ConstTerm<Terms>...>(TryStore<TermComponent<Terms>>()...);
+    }
+
+    // Returns the owning group for the components, creating it on first use.
+    // Throws if one of the pools is already owned by a different group.
+    template <typename... Owned>
+    OwningGroup<Owned...>& Group()
+    {
+        if (auto* existing = TryGroup<Owned...>())
+        {
+            return *existing;
+        }
+
+        RequireNoParallelIteration();
+        auto group = std::make_unique<OwningGroup<Owned...>>(&MutableStore<Owned>()...);
+        auto* ptr = group.get();
+        m_groups.push_back(std::move(group));
+        return *ptr;
+    }
+
+    // Calls func(entity, terms...) for every entity matching the query terms:
+    // plain components (T&), With<T>, Without<T> and Optional<T> (T*), see View.h.
+    // Walks the smallest required pool and probes the other terms; when an owning
+    // group owns exactly the required components only the group range is walked.
+    // The callback may modify component values but must not add or remove
+    // components of the iterated types: pools are packed and reorder on removal.
+    template <typename... Terms, typename Func>
+    void ForEach(Func&& func)
+    {
+        Query<Terms...>().Each(std::forward<Func>(func));
+    }
+
+    template <typename... Terms, typename Func>
+    void ForEach(Func&& func) const
+    {
+        Query<Terms...>().Each(std::forward<Func>(func));
+    }
+
+    // Parallel ForEach: the matching range is split into batches of at least
+    // minBatch entities that run concurrently on the shared job system.
+    // Rules for the callback:
+    //  - it may read and write only the components it is handed (plus its own
+    //    thread-safe state); entities in different batches run on different threads;
+    //  - no structural changes for the duration of the call: creating or destroying
+    //    entities and adding or removing components of any type throws
+    //    std::runtime_error. Record such changes and apply them after the call.
+    template <typename... Terms, typename Func>
+    void ParallelForEach(Func&& func, const std::size_t minBatch = kDefaultParallelBatch)
+    {
+        const ParallelScope scope(*this);
+        Query<Terms...>().ParallelEach(func, minBatch);
+    }
+
+    template <typename... Terms, typename Func>
+    void ParallelForEach(Func&& func, const std::size_t minBatch = kDefaultParallelBatch) const
+    {
+        const ParallelScope scope(*this);
+        Query<Terms...>().ParallelEach(func, minBatch);
+    }
+
+private:
+    using IStore = IComponentStore;
 
     template <typename Component>
-    struct Store final : IStore
+    using Store = StoreFor<Component>;
+
+    class ParallelScope
     {
-        std::unordered_map<EntityId, Component> data;
+    public:
+        explicit ParallelScope(const Registry& registry) : m_registry(registry)
+        {
+            m_registry.m_parallelIterations.fetch_add(1);
+        }
 
-        void Remove(const EntityId id) override
+        ~ParallelScope()
         {
-            data.erase(id);
+            m_registry.m_parallelIterations.fetch_sub(1);
         }
+
+        ParallelScope(const ParallelScope&) = delete;
+        ParallelScope& operator=(const ParallelScope&) = delete;
+
+    private:
+        const Registry& m_registry;
     };
 
-    template <typename Component>
-    Store<Component>* TryStore()
+    // A group is found through the owner of its first pool.
+    template <typename First, typename... Rest>
+    OwningGroup<First, Rest...>* TryGroup()
+    {
+        auto* pool = TryStore<First>();
+        return (pool != nullptr) ? dynamic_cast<OwningGroup<First, Rest...>*>(pool->Owner()) : nullptr;
+    }
+
+    // Size of the owning group whose owned types are exactly Required, if any.
+    template <typename... Required>
+    [[nodiscard]] std::optional<std::size_t> GroupSize(std::tuple<Required...>* /*required*/) const
     {
-        const auto it = m_componentStores.find(std::type_index(typeid(Component)));
-        if (it == m_componentStores.end())
+        if constexpr (sizeof...(Required) >= 2)
         {
-            return nullptr;
+            const auto* pool = TryStore<std::tuple_element_t<0, std::tuple<Required...>>>();
+            if (const auto* group = (pool != nullptr) ? dynamic_cast<const OwningGroup<Required...>*>(pool->Owner()) : nullptr)
+            {
+                return group->Size();
+            }
         }
-        return static_cast<Store<Component>*>(it->second.get());
+        return std::nullopt;
     }
 
-    template <typename Component>
-    const Store<Component>* TryStore() const
+    template <typename... Terms>
+    [[nodiscard]] ComponentView<Terms...> Query()
+    {
+        ComponentView<Terms...> view(TryStore<TermComponent<Terms>>()...);
+        if (const auto size = GroupSize(static_cast<RequiredComponents<Terms...>*>(nullptr)))
+        {
+            view.RestrictToGroup(*size);
+        }
+        return view;
+    }
+
+    template <typename... Terms>
+    [[nodiscard]] ComponentView<ConstTerm<Terms>...> Query() const
     {
-        const auto it = m_componentStores.find(std::type_index(typeid(Component)));
-        if (it == m_componentStores.end())
+        ComponentView<ConstTerm<Terms>...> view(TryStore<TermComponent<Terms>>()...);
+        if (const auto size = GroupSize(static_cast<RequiredComponents<Terms...>*>(nullptr)))
         {
-            return nullptr;
+            view.RestrictToGroup(*size);
         }
-        return static_cast<const Store<Component>*>(it->second.get());
+        return view;
+    }
+
+    template <typename Component>
+    Store<Component>* TryStore()
+    {
+        const std::size_t typeId = ComponentTypeId<Component>();
+        return (typeId < m_componentStores.size()) ? static_cast<Store<Component>*>(m_componentStores[typeId].get()) : nullptr;
+    }
+
+    template <typename Component>
+    const Store<Component>* TryStore() const
+    {
+        const std::size_t typeId = ComponentTypeId<Component>();
+        return (typeId < m_componentStores.size()) ? static_cast<const Store<Component>*>(m_componentStores[typeId].get()) : nullptr;
     }
 
     template <typename Component>
     Store<Component>& MutableStore()
     {
-        const auto key = std::type_index(typeid(Component));
-        const auto it = m_componentStores.find(key);
-        if (it != m_componentStores.end())
+        if (auto* store = TryStore<Component>())
+        {
+            return *store;
+        }
+
+        RequireNoParallelIteration();
+        const std::size_t typeId = ComponentTypeId<Component>();
+        if (typeId >= m_componentStores.size())
         {
-            return *static_cast<Store<Component>*>(it->second.get());
+            m_componentStores.resize(typeId + 1);
         }
 
         auto store = std::make_unique<Store<Component>>();
         auto* ptr = store.get();
-        m_componentStores.emplace(key, std::move(store));
+        m_componentStores[typeId] = std::move(store);
         return *ptr;
     }
 
+    // Throws unless count more entities fit into the index space.
+    void RequireIndexSpace(const std::size_t count) const
+    {
+        const std::size_t reused = std::min(count, m_freeIndices.size());
+        const std::size_t available = (static_cast<std::size_t>(kEntityIndexMask) + 1) - m_slots.size();
+        if ((count - reused) > available)
+        {
+            throw std::runtime_error("Entity index space is exhausted.");
+        }
+    }
+
+    EntityId AllocateEntity()
+    {
+        std::uint32_t index = 0;
+        if (!m_freeIndices.empty())
+        {
+            index = m_freeIndices.back();
+            m_freeIndices.pop_back();
+        }
+        else
+        {
+            index = static_cast<std::uint32_t>(m_slots.size());
+            m_slots.push_back(MakeEntityId(index, 0));
+            m_positions.push_back(kNoPosition);
+        }
+
+        const EntityId id = m_slots[index];
+        m_positions[index] = static_cast<std::uint32_t>(m_entities.size());
+        m_entities.push_back(id);
+        return id;
+    }
+
     void RequireAlive(const EntityId id) const
     {
         if (!IsAlive(id))
@@ -198,9 +431,35 @@ private:
         }
     }
 
-    EntityId m_nextId = 1;
+    // Tag bits are keyed by index only; data pools already reject stale handles.
+    template <typename Component>
+    void RequireTagOwnerAlive(const EntityId id) const
+    {
+        if (std::is_empty_v<Component> && !IsAlive(id))
+        {
+            throw std::runtime_error("Component is missing on entity.");
+        }
+    }
+
+    void RequireNoParallelIteration() const
+    {
+        if (m_parallelIterations.load(std::memory_order_relaxed) != 0)
+        {
+            throw std::runtime_error("Structural registry change during ParallelForEach.");
+        }
+    }
+
+    static constexpr std::uint32_t kNoPosition = 0xffffffffU;
+
+    // Indexed by entity index: the current handle of the slot and its position in
+    // m_entities. Slot 0 is a permanent placeholder so InvalidEntity never resolves.
+    std::vector<EntityId> m_slots {InvalidEntity};
+    std::vector<std::uint32_t> m_positions {kNoPosition};
+    std::vector<std::uint32_t> m_freeIndices;
     std::vector<EntityId> m_entities;
-    std::unordered_set<EntityId> m_alive;
-    std::unordered_map<std::type_index, std::unique_ptr<IStore>> m_componentStores;
+    // Indexed by ComponentTypeId; null for component types this registry never stored.
+    std::vector<std::unique_ptr<IStore>> m_componentStores;
+    std::vector<std::unique_ptr<IPoolObserver>> m_groups;
+    mutable std::atomic<std::uint32_t> m_parallelIterations {0};
 };
 } // namespace rg::ecs
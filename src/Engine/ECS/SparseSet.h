@@ -0,0 +1,443 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "Engine/ECS/EntityId.h"
+
+namespace rg::ecs
+{
+// Notified by a pool right after an entity is inserted and right before one is
+// erased, while the pool is still in a consistent state. Owning groups use this
+// to keep their pools partitioned.
+class IPoolObserver
+{
+public:
+    virtual ~IPoolObserver() = default;
+
+    virtual void OnInsert(EntityId id) = 0;
+    virtual void OnErase(EntityId id) = 0;
+};
+
+// Type-erased per-component storage as seen by the registry when an entity is
+// destroyed.
+class IComponentStore
+{
+public:
+    virtual ~IComponentStore() = default;
+
+    virtual void RemoveEntity(EntityId id) = 0;
+};
+
+// Entity membership set: a packed array of entity ids plus a paged sparse index
+// mapping an entity index to its slot in the packed array. Pages are allocated on
+// first use, so large or sparse id ranges do not cost memory up front. The packed
+// array keeps full handles, so a stale version of a recycled index is not contained.
+class SparseSet : public IComponentStore
+{
+public:
+    static constexpr std::size_t kPageSize = 4096;
+    static constexpr std::uint32_t kNullSlot = std::numeric_limits<std::uint32_t>::max();
+
+    virtual ~SparseSet() = default;
+
+    [[nodiscard]] bool Contains(const EntityId id) const
+    {
+        const std::uint32_t slot = Slot(id);
+        return (slot != kNullSlot) && (m_dense[slot] == id);
+    }
+
+    // Packed index of the entity. The entity must be contained in the set.
+    [[nodiscard]] std::size_t IndexOf(const EntityId id) const
+    {
+        return Slot(id);
+    }
+
+    [[nodiscard]] std::size_t Size() const
+    {
+        return m_dense.size();
+    }
+
+    [[nodiscard]] bool Empty() const
+    {
+        return m_dense.empty();
+    }
+
+    [[nodiscard]] const std::vector<EntityId>& Entities() const
+    {
+        return m_dense;
+    }
+
+    void Remove(const EntityId id)
+    {
+        if (!Contains(id))
+        {
+            return;
+        }
+
+        NotifyErase(id);
+        EraseAt(IndexOf(id));
+    }
+
+    void RemoveEntity(const EntityId id) override
+    {
+        Remove(id);
+    }
+
+    // Exchanges two packed positions without changing membership.
+    virtual void SwapAt(const std::size_t a, const std::size_t b)
+    {
+        if (a == b)
+        {
+            return;
+        }
+
+        const EntityId entityA = m_dense[a];
+        const EntityId entityB = m_dense[b];
+        m_dense[a] = entityB;
+        m_dense[b] = entityA;
+        SlotRef(entityA) = static_cast<std::uint32_t>(b);
+        SlotRef(entityB) = static_cast<std::uint32_t>(a);
+    }
+
+    void AddObserver(IPoolObserver* observer)
+    {
+        m_observers.push_back(observer);
+    }
+
+    void RemoveObserver(IPoolObserver* observer)
+    {
+        std::erase(m_observers, observer);
+    }
+
+    // A pool can be owned (reordered) by at most one group.
+    [[nodiscard]] IPoolObserver* Owner() const
+    {
+        return m_owner;
+    }
+
+    void SetOwner(IPoolObserver* owner)
+    {
+        m_owner = owner;
+        AddObserver(owner);
+    }
+
+protected:
+    // Swap-and-pop of the packed position.
+    virtual void EraseAt(const std::size_t index)
+    {
+        const EntityId id = m_dense[index];
+        const EntityId last = m_dense.back();
+        m_dense[index] = last;
+        SlotRef(last) = static_cast<std::uint32_t>(index);
+        SlotRef(id) = kNullSlot;
+        m_dense.pop_back();
+    }
+
+    std::size_t Insert(const EntityId id)
+    {
+        const std::size_t index = m_dense.size();
+        m_dense.push_back(id);
+        SlotRef(id) = static_cast<std::uint32_t>(index);
+        return index;
+    }
+
+    void NotifyInsert(const EntityId id)
+    {
+        for (IPoolObserver* observer : m_observers)
+        {
+            observer->OnInsert(id);
+        }
+    }
+
+    void NotifyErase(const EntityId id)
+    {
+        for (IPoolObserver* observer : m_observers)
+        {
+            observer->OnErase(id);
+        }
+    }
+
+    void ReserveDense(const std::size_t capacity)
+    {
+        m_dense.reserve(capacity);
+    }
+
+private:
+    using Page = std::array<std::uint32_t, kPageSize>;
+
+    [[nodiscard]] std::uint32_t Slot(const EntityId id) const
+    {
+        const std::size_t page = EntityIndex(id) / kPageSize;
+        if ((page >= m_sparse.size()) || (m_sparse[page] == nullptr))
+        {
+            return kNullSlot;
+        }
+        return (*m_sparse[page])[EntityIndex(id) % kPageSize];
+    }
+
+    std::uint32_t& SlotRef(const EntityId id)
+    {
+        const std::size_t page = EntityIndex(id) / kPageSize;
+        if (page >= m_sparse.size())
+        {
+            m_sparse.resize(page + 1);
+        }
+
+        auto& pagePtr = m_sparse[page];
+        if (pagePtr == nullptr)
+        {
+            pagePtr = std::make_unique<Page>();
+            pagePtr->fill(kNullSlot);
+        }
+        return (*pagePtr)[EntityIndex(id) % kPageSize];
+    }
+
+    std::vector<EntityId> m_dense;
+    std::vector<std::unique_ptr<Page>> m_sparse;
+    std::vector<IPoolObserver*> m_observers;
+    IPoolObserver* m_owner = nullptr;
+};
+
+// Sparse set that also stores one component per entity, packed in the same order
+// as the entity array so iteration is a linear walk over contiguous memory.
+//
+// Each element carries the pool version at which it was last marked changed, and
+// the first mark of an element in a version is appended to a change log, so
+// ForEachChanged walks only the log entries newer than its checkpoint instead of
+// the whole pool. Marking only reads the pool version and locks the log for the
+// append, so elements can be marked concurrently from a parallel iteration;
+// ForEachChanged bumps the version so marks made after it started are reported
+// to the next call.
+template <typename Component>
+class ComponentPool final : public SparseSet
+{
+public:
+    template <typename... Args>
+    Component& Emplace(const EntityId id, Args&&... args)
+    {
+        // Construct first: arguments may alias an element of m_data (e.g. copying a
+        // component from another entity) and push_back can reallocate.
+        Component value(std::forward<Args>(args)...);
+        if (Contains(id))
+        {
+            const std::size_t index = IndexOf(id);
+            m_data[index] = std::move(value);
+            MarkChangedAt(index);
+            return m_data[index];
+        }
+
+        Insert(id);
+        m_data.push_back(std::move(value));
+        m_changed.push_back({m_version, m_changeLog.size()});
+        m_changeLog.push_back({id, m_version});
+        NotifyInsert(id);
+        // Observers may have moved the new element.
+        return m_data[IndexOf(id)];
+    }
+
+    void SwapAt(const std::size_t a, const std::size_t b) override
+    {
+        if (a == b)
+        {
+            return;
+        }
+
+        std::swap(m_data[a], m_data[b]);
+        std::swap(m_changed[a], m_changed[b]);
+        SparseSet::SwapAt(a, b);
+    }
+
+    void Reserve(const std::size_t capacity)
+    {
+        ReserveDense(capacity);
+        m_data.reserve(capacity);
+        m_changed.reserve(capacity);
+    }
+
+    // Bulk insert of one copy of value per entity. The entities must not be in
+    // the pool yet (e.g. freshly created ones).
+    void InsertCopies(const std::vector<EntityId>& ids, const Component& value)
+    {
+        const std::size_t required = m_data.size() + ids.size();
+        if (required > m_data.capacity())
+        {
+            Reserve(std::max(required, m_data.capacity() * 2));
+        }
+
+        for (const EntityId id : ids)
+        {
+            Insert(id);
+        }
+        m_data.insert(m_data.end(), ids.size(), value);
+        for (const EntityId id : ids)
+        {
+            m_changed.push_back({m_version, m_changeLog.size()});
+            m_changeLog.push_back({id, m_version});
+        }
+
+        for (const EntityId id : ids)
+        {
+            NotifyInsert(id);
+        }
+    }
+
+    void MarkChanged(const EntityId id)
+    {
+        if (Contains(id))
+        {
+            MarkChangedAt(IndexOf(id));
+        }
+    }
+
+    void MarkChangedAt(const std::size_t index)
+    {
+        ChangeStamp& stamp = m_changed[index];
+        if (stamp.version == m_version)
+        {
+            return;
+        }
+
+        stamp.version = m_version;
+        const std::lock_guard lock(m_changeLogMutex);
+        stamp.entry = m_changeLog.size();
+        m_changeLog.push_back({Entities()[index], m_version});
+    }
+
+    [[nodiscard]] std::uint64_t Version() const
+    {
+        return m_version;
+    }
+
+    // Calls func(entity, component) for every element marked after sinceVersion
+    // and returns the version to pass next time. Start from 0 to visit everything.
+    template <typename Func>
+    std::uint64_t ForEachChanged(const std::uint64_t sinceVersion, Func&& func)
+    {
+        CompactChangeLog();
+        const std::uint64_t checkpoint = m_version++;
+
+        // The log is ordered by version. An entity marked in several versions (or
+        // removed and added again) has several entries; only the latest one is
+        // reported, and entries of removed entities match nothing.
+        const auto first = std::upper_bound(m_changeLog.begin(), m_changeLog.end(), sinceVersion,
+            [](const std::uint64_t version, const ChangeRecord& record)
+            {
+                return version < record.version;
+            });
+        const std::size_t end = m_changeLog.size();
+        for (auto position = static_cast<std::size_t>(first - m_changeLog.begin()); position < end; ++position)
+        {
+            const ChangeRecord record = m_changeLog[position];
+            if (!Contains(record.id))
+            {
+                continue;
+            }
+            const std::size_t index = IndexOf(record.id);
+            if (m_changed[index].entry == position)
+            {
+                func(record.id, m_data[index]);
+            }
+        }
+        return checkpoint;
+    }
+
+    [[nodiscard]] Component& Get(const EntityId id)
+    {
+        if (!Contains(id))
+        {
+            throw std::runtime_error("Component is missing on entity.");
+        }
+        return m_data[IndexOf(id)];
+    }
+
+    [[nodiscard]] const Component& Get(const EntityId id) const
+    {
+        if (!Contains(id))
+        {
+            throw std::runtime_error("Component is missing on entity.");
+        }
+        return m_data[IndexOf(id)];
+    }
+
+    [[nodiscard]] Component& At(const std::size_t index)
+    {
+        return m_data[index];
+    }
+
+    [[nodiscard]] const Component& At(const std::size_t index) const
+    {
+        return m_data[index];
+    }
+
+protected:
+    void EraseAt(const std::size_t index) override
+    {
+        if (index + 1 != m_data.size())
+        {
+            m_data[index] = std::move(m_data.back());
+            m_changed[index] = m_changed.back();
+        }
+        m_data.pop_back();
+        m_changed.pop_back();
+        SparseSet::EraseAt(index);
+    }
+
+private:
+    struct ChangeStamp
+    {
+        std::uint64_t version = 0;
+        // Position of the element's latest entry in m_changeLog.
+        std::size_t entry = 0;
+    };
+
+    struct ChangeRecord
+    {
+        EntityId id = InvalidEntity;
+        std::uint64_t version = 0;
+    };
+
+    // Drops superseded entries and those of removed entities once they make up
+    // most of the log, keeping it proportional to the pool size.
+    void CompactChangeLog()
+    {
+        if (m_changeLog.size() <= (2 * m_data.size()) + kMinChangeLogSize)
+        {
+            return;
+        }
+
+        std::size_t kept = 0;
+        for (std::size_t position = 0; position < m_changeLog.size(); ++position)
+        {
+            const ChangeRecord record = m_changeLog[position];
+            if (!Contains(record.id))
+            {
+                continue;
+            }
+            ChangeStamp& stamp = m_changed[IndexOf(record.id)];
+            if (stamp.entry == position)
+            {
+                stamp.entry = kept;
+                m_changeLog[kept++] = record;
+            }
+        }
+        m_changeLog.resize(kept);
+    }
+
+    static constexpr std::size_t kMinChangeLogSize = 64;
+
+    std::vector<Component> m_data;
+    std::vector<ChangeStamp> m_changed;
+    std::vector<ChangeRecord> m_changeLog;
+    std::mutex m_changeLogMutex;
+    std::uint64_t m_version = 1;
+};
+} // namespace rg::ecs
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "Engine/ECS/EntityId.h"
+#include "Engine/ECS/SparseSet.h"
+
+namespace rg::ecs
+{
+// Storage for a zero-size tag component: one membership bit per entity index.
+// A membership test is a shift and a mask, with no sparse page or packed array,
+// so tags are cheap to use as query filters (With<Tag> / Without<Tag>).
+//
+// Bits are keyed by entity index only. The registry clears an entity's bits when
+// it is destroyed, so a bit always belongs to the current occupant of the slot;
+// callers holding possibly stale handles must check IsAlive first.
+template <typename Tag>
+class TagPool final : public IComponentStore
+{
+public:
+    static_assert(std::is_empty_v<Tag>, "Tag pools store empty component types only.");
+
+    [[nodiscard]] bool Contains(const EntityId id) const
+    {
+        const std::size_t word = EntityIndex(id) / kBitsPerWord;
+        return (word < m_bits.size()) && ((m_bits[word] & Mask(id)) != 0);
+    }
+
+    [[nodiscard]] std::size_t Size() const
+    {
+        return m_size;
+    }
+
+    template <typename... Args>
+    Tag& Emplace(const EntityId id, Args&&... /*args*/)
+    {
+        const std::size_t word = EntityIndex(id) / kBitsPerWord;
+        if (word >= m_bits.size())
+        {
+            m_bits.resize(word + 1, 0);
+        }
+
+        if ((m_bits[word] & Mask(id)) == 0)
+        {
+            m_bits[word] |= Mask(id);
+            ++m_size;
+        }
+        return m_instance;
+    }
+
+    void InsertCopies(const std::vector<EntityId>& ids, const Tag& /*value*/)
+    {
+        for (const EntityId id : ids)
+        {
+            Emplace(id);
+        }
+    }
+
+    void Remove(const EntityId id)
+    {
+        if (Contains(id))
+        {
+            m_bits[EntityIndex(id) / kBitsPerWord] &= ~Mask(id);
+            --m_size;
+        }
+    }
+
+    void RemoveEntity(const EntityId id) override
+    {
+        Remove(id);
+    }
+
+    [[nodiscard]] Tag& Get(const EntityId id)
+    {
+        if (!Contains(id))
+        {
+            throw std::runtime_error("Component is missing on entity.");
+        }
+        return m_instance;
+    }
+
+    [[nodiscard]] const Tag& Get(const EntityId id) const
+    {
+        if (!Contains(id))
+        {
+            throw std::runtime_error("Component is missing on entity.");
+        }
+        return m_instance;
+    }
+
+private:
+    static constexpr std::size_t kBitsPerWord = 64;
+
+    [[nodiscard]] static std::uint64_t Mask(const EntityId id)
+    {
+        return std::uint64_t {1} << (EntityIndex(id) % kBitsPerWord);
+    }
+
+    std::vector<std::uint64_t> m_bits;
+    std::size_t m_size = 0;
+    // Every entity shares the one (stateless) instance handed out by Get/Emplace.
+    Tag m_instance {};
+};
+} // namespace rg::ecs
@@ -0,0 +1,317 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "Engine/Core/JobSystem.h"
+#include "Engine/ECS/EntityId.h"
+#include "Engine/ECS/SparseSet.h"
+#include "Engine/ECS/TagPool.h"
+
+namespace rg::ecs
+{
+// Query terms. A plain component type is required and handed to the callback by
+// reference; the wrappers change how a term filters and what it hands over:
+//  - With<T>: required, nothing is passed (the way to require a tag);
+//  - Without<T>: entities that have T are skipped, nothing is passed;
+//  - Optional<T>: does not filter, passed as T* (null when the entity lacks T).
+template <typename Component>
+struct With
+{
+};
+
+template <typename Component>
+struct Without
+{
+};
+
+template <typename Component>
+struct Optional
+{
+};
+
+// Storage used for a component type: empty (tag) types live in bitset pools.
+template <typename Component>
+using StoreFor = std::conditional_t<std::is_empty_v<Component>, TagPool<Component>, ComponentPool<Component>>;
+
+// Pool type for a (possibly const-qualified) component in a query.
+template <typename Component>
+using PoolFor = std::conditional_t<
+    std::is_const_v<Component>,
+    const StoreFor<std::remove_const_t<Component>>,
+    StoreFor<Component>>;
+
+enum class TermKind
+{
+    Required,
+    With,
+    Without,
+    Optional
+};
+
+template <typename Term>
+struct TermTraits
+{
+    static constexpr TermKind kKind = TermKind::Required;
+    using Component = std::remove_const_t<Term>;
+    using Pool = PoolFor<Term>;
+    using Const = const Term;
+};
+
+template <typename Inner>
+struct TermTraits<With<Inner>>
+{
+    static constexpr TermKind kKind = TermKind::With;
+    using Component = std::remove_const_t<Inner>;
+    using Pool = const StoreFor<Component>;
+    using Const = With<Inner>;
+};
+
+template <typename Inner>
+struct TermTraits<Without<Inner>>
+{
+    static constexpr TermKind kKind = TermKind::Without;
+    using Component = std::remove_const_t<Inner>;
+    using Pool = const StoreFor<Component>;
+    using Const = Without<Inner>;
+};
+
+template <typename Inner>
+struct TermTraits<Optional<Inner>>
+{
+    static constexpr TermKind kKind = TermKind::Optional;
+    using Component = std::remove_const_t<Inner>;
+    using Pool = PoolFor<Inner>;
+    using Const = Optional<const Inner>;
+};
+
+// Component type a term refers to, without const.
+template <typename Term>
+using TermComponent = typename TermTraits<Term>::Component;
+
+// The term as seen through a const registry.
+template <typename Term>
+using ConstTerm = typename TermTraits<Term>::Const;
+
+template <typename Term>
+using RequiredOf = std::conditional_t<
+    TermTraits<Term>::kKind == TermKind::Required,
+    std::tuple<TermComponent<Term>>,
+    std::tuple<>>;
+
+// Required (callback-visible) components of a query, in order, as a std::tuple.
+template <typename... Terms>
+using RequiredComponents = decltype(std::tuple_cat(std::declval<RequiredOf<Terms>>()...));
+
+// Non-owning query over a set of terms. Pool pointers are resolved once when the
+// view is built, so a view can be kept by a system and reused across frames.
+// Each() walks the smallest required pool and probes the other terms.
+template <typename... Terms>
+class ComponentView
+{
+public:
+    static_assert(
+        ((TermTraits<Terms>::kKind == TermKind::Required) || ...),
+        "A query needs at least one required data component to iterate.");
+    static_assert(
+        (!((TermTraits<Terms>::kKind == TermKind::Required || TermTraits<Terms>::kKind == TermKind::Optional) &&
+           std::is_empty_v<TermComponent<Terms>>) && ...),
+        "Tag components are filters: use With<Tag> or Without<Tag>.");
+
+    ComponentView() = default;
+
+    explicit ComponentView(typename TermTraits<Terms>::Pool*... pools) : m_pools(pools...)
+    {
+    }
+
+    [[nodiscard]] bool IsValid() const
+    {
+        return IsValidImpl(std::index_sequence_for<Terms...> {});
+    }
+
+    // Upper bound on the number of entities the view yields.
+    [[nodiscard]] std::size_t SizeHint() const
+    {
+        const SparseSet* driver = Driver();
+        return (driver != nullptr) ? std::min(driver->Size(), m_lockstepSize) : 0;
+    }
+
+    [[nodiscard]] bool Contains(const EntityId id) const
+    {
+        return IsValid() && ContainsImpl(id, std::index_sequence_for<Terms...> {});
+    }
+
+    // Used when an owning group owns exactly the required components: the first
+    // size entries of every required pool are then the candidates, in the same
+    // order, so required terms need no sparse lookups.
+    void RestrictToGroup(const std::size_t size)
+    {
+        m_lockstepSize = size;
+    }
+
+    // The callback is called as func(entity, terms...) and may modify component
+    // values but must not add or remove components of the viewed types: pools are
+    // packed and reorder on removal.
+    template <typename Func>
+    void Each(Func&& func) const
+    {
+        const SparseSet* driver = Driver();
+        if (driver == nullptr)
+        {
+            return;
+        }
+
+        const std::size_t count = std::min(driver->Size(), m_lockstepSize);
+        for (std::size_t index = 0; index < count; ++index)
+        {
+            Visit(*driver, index, func, std::index_sequence_for<Terms...> {});
+        }
+    }
+
+    // Same as Each() but splits the driving pool into batches that run on the
+    // shared job system. The callback runs concurrently and must be thread-safe.
+    template <typename Func>
+    void ParallelEach(Func&& func, const std::size_t minBatch) const
+    {
+        const SparseSet* driver = Driver();
+        if (driver == nullptr)
+        {
+            return;
+        }
+
+        const std::size_t count = std::min(driver->Size(), m_lockstepSize);
+        JobSystem::Shared().ParallelFor(count, minBatch, [&](const std::size_t begin, const std::size_t end)
+        {
+            for (std::size_t index = begin; index < end; ++index)
+            {
+                Visit(*driver, index, func, std::index_sequence_for<Terms...> {});
+            }
+        });
+    }
+
+private:
+    template <std::size_t I>
+    using TermAt = std::tuple_element_t<I, std::tuple<Terms...>>;
+
+    template <std::size_t I>
+    static constexpr TermKind kKindAt = TermTraits<TermAt<I>>::kKind;
+
+    [[nodiscard]] bool Lockstep() const
+    {
+        return m_lockstepSize != std::numeric_limits<std::size_t>::max();
+    }
+
+    template <std::size_t... I>
+    [[nodiscard]] bool IsValidImpl(std::index_sequence<I...> /*indices*/) const
+    {
+        return (((kKindAt<I> != TermKind::Required && kKindAt<I> != TermKind::With) || (std::get<I>(m_pools) != nullptr)) && ...);
+    }
+
+    template <std::size_t... I>
+    [[nodiscard]] bool ContainsImpl(const EntityId id, std::index_sequence<I...> /*indices*/) const
+    {
+        return (Accepts<I>(nullptr, id) && ...);
+    }
+
+    [[nodiscard]] const SparseSet* Driver() const
+    {
+        if (!IsValid())
+        {
+            return nullptr;
+        }
+
+        const SparseSet* driver = nullptr;
+        DriverImpl(driver, std::index_sequence_for<Terms...> {});
+        return driver;
+    }
+
+    template <std::size_t... I>
+    void DriverImpl(const SparseSet*& driver, std::index_sequence<I...> /*indices*/) const
+    {
+        (ConsiderDriver<I>(driver), ...);
+    }
+
+    template <std::size_t I>
+    void ConsiderDriver(const SparseSet*& driver) const
+    {
+        if constexpr (kKindAt<I> == TermKind::Required)
+        {
+            const SparseSet* pool = std::get<I>(m_pools);
+            if ((driver == nullptr) || (pool->Size() < driver->Size()))
+            {
+                driver = pool;
+            }
+        }
+    }
+
+    // Membership test of one term; required pools are skipped when they drive the
+    // walk or when a group guarantees membership.
+    template <std::size_t I>
+    [[nodiscard]] bool Accepts(const SparseSet* driver, const EntityId entity) const
+    {
+        const auto* pool = std::get<I>(m_pools);
+        if constexpr (kKindAt<I> == TermKind::Required)
+        {
+            return (driver != nullptr && (Lockstep() || static_cast<const SparseSet*>(pool) == driver)) || pool->Contains(entity);
+        }
+        else if constexpr (kKindAt<I> == TermKind::With)
+        {
+            return pool->Contains(entity);
+        }
+        else if constexpr (kKindAt<I> == TermKind::Without)
+        {
+            return (pool == nullptr) || !pool->Contains(entity);
+        }
+        else
+        {
+            return true;
+        }
+    }
+
+    // Callback arguments of one term, as a tuple: (T&), (T*) or ().
+    template <std::size_t I>
+    [[nodiscard]] auto Fetch(const SparseSet& driver, const std::size_t driverIndex, const EntityId entity) const
+    {
+        auto* pool = std::get<I>(m_pools);
+        if constexpr (kKindAt<I> == TermKind::Required)
+        {
+            const bool direct = Lockstep() || (static_cast<const SparseSet*>(pool) == &driver);
+            return std::forward_as_tuple(pool->At(direct ? driverIndex : pool->IndexOf(entity)));
+        }
+        else if constexpr (kKindAt<I> == TermKind::Optional)
+        {
+            using Pointer = decltype(&pool->At(0));
+            const bool present = (pool != nullptr) && pool->Contains(entity);
+            return std::tuple<Pointer>(present ? &pool->At(pool->IndexOf(entity)) : nullptr);
+        }
+        else
+        {
+            return std::tuple<>();
+        }
+    }
+
+    template <typename Func, std::size_t... I>
+    void Visit(const SparseSet& driver, const std::size_t index, Func& func, std::index_sequence<I...> /*indices*/) const
+    {
+        const EntityId entity = driver.Entities()[index];
+        if (!(Accepts<I>(&driver, entity) && ...))
+        {
+            return;
+        }
+
+        std::apply(
+            [&func, entity](auto&&... args)
+            {
+                func(entity, std::forward<decltype(args)>(args)...);
+            },
+            std::tuple_cat(Fetch<I>(driver, index, entity)...));
+    }
+
+    std::tuple<typename TermTraits<Terms>::Pool*...> m_pools {};
+    std::size_t m_lockstepSize = std::numeric_limits<std::size_t>::max();
+};
+} // namespace rg::ecs
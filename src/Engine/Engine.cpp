@@ -1,57 +1,114 @@
 #include "Engine/Engine.h"
 
+#include <algorithm>
 #include <chrono>
+#include <cmath>
+#include <cstdio>
 #include <string>
-#include <thread>
+#include <vector>
 #include <utility>
 
+#include "Engine/Core/FrameAllocator.h"
+#include "Engine/Core/FramePacer.h"
+#include "Engine/Core/JobSystem.h"
 #include "Engine/Core/Log.h"
+#include "Engine/Core/Profiler.h"
 #include "Engine/Systems/PhysicsSystem.h"
 #include "Engine/Systems/RenderSystem.h"
 #include "Engine/Systems/ScriptSystem.h"
 #include "Engine/Systems/SystemContext.h"
 #include "Engine/Systems/VoxelGameplaySystem.h"
+#include "Engine/Systems/VoxelStreamingSystem.h"
 
 namespace rg
 {
+namespace
+{
+// Longest frame time fed into the simulation accumulator.
+constexpr double kMaxFrameSeconds = 0.25;
+
+std::string FormatMilliseconds(const double milliseconds)
+{
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), "%.4f", milliseconds);
+    return buffer;
+}
+
+// The headless report is the output of that mode, so it bypasses the level
+// filter (RG_LOG_MIN_LEVEL) that quiets per-frame logging.
+void WriteReport(const std::string& line)
+{
+    Log::Flush();
+    std::fputs(line.c_str(), stdout);
+    std::fputc('\n', stdout);
+    std::fflush(stdout);
+}
+} // namespace
+
 Engine::Engine(EngineConfig config) : m_config(std::move(config))
 {
 }
 
 bool Engine::Initialize()
 {
+    if (!m_config.logFilePath.empty() && !Log::OpenFile(m_config.logFilePath))
+    {
+        Log::Write(LogLevel::Warning, "Failed to open log file: " + m_config.logFilePath.string());
+    }
+
     Log::Write(LogLevel::Info, "Initializing project: " + m_config.projectName);
 
     m_resources.SetRoot(m_config.assetRoot);
-    if (!m_windowSystem.Initialize(m_config.window))
+    if (m_config.headless)
     {
-        Log::Write(LogLevel::Error, "Window system initialization failed.");
-        return false;
+        Log::Write(LogLevel::Info, "Headless mode: window, renderer and editor are disabled.");
     }
+    else
+    {
+        if (!m_windowSystem.Initialize(m_config.window))
+        {
+            Log::Write(LogLevel::Error, "Window system initialization failed.");
+            return false;
+        }
 
-    RenderBackendContext renderContext;
-    renderContext.nativeWindowHandle = m_windowSystem.NativeHandle();
-    renderContext.width = m_windowSystem.Width();
-    renderContext.height = m_windowSystem.Height();
+        RenderBackendContext renderContext;
+        renderContext.nativeWindowHandle = m_windowSystem.NativeHandle();
+        renderContext.width = m_windowSystem.Width();
+        renderContext.height = m_windowSystem.Height();
 
-    if (!m_renderer.Initialize(RendererConfig {m_config.renderAPI, m_config.vsync}, m_resources, renderContext))
-    {
-        Log::Write(LogLevel::Error, "Renderer initialization failed.");
-        return false;
+        if (!m_renderer.Initialize(RendererConfig {m_config.renderAPI, m_config.vsync, m_config.renderThread}, m_resources, renderContext))
+        {
+            Log::Write(LogLevel::Error, "Renderer initialization failed.");
+            return false;
+        }
     }
 
     m_scriptHost.Initialize();
 
-    if (m_config.enableVoxelSandbox)
+    if (m_config.enableVoxelSandbox && m_config.voxelStreaming && !m_config.headless)
     {
+        m_voxelWorld.Reset(m_config.voxelWorldSeed);
+        Log::Write(
+            LogLevel::Info,
+            "Voxel world streaming: view distance=" + std::to_string(m_config.voxelWorldRadiusInChunks) +
+                " chunks, seed=" + std::to_string(m_config.voxelWorldSeed));
+    }
+    else if (m_config.enableVoxelSandbox)
+    {
+        const auto generateStart = std::chrono::steady_clock::now();
         m_voxelWorld.Generate(m_config.voxelWorldRadiusInChunks, m_config.voxelWorldSeed);
+        const double generateSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - generateStart).count();
+        const double chunks = static_cast<double>(m_voxelWorld.LoadedChunkCount());
         Log::Write(
             LogLevel::Info,
             "Voxel world generated: radius=" + std::to_string(m_config.voxelWorldRadiusInChunks) +
-                " chunks, seed=" + std::to_string(m_config.voxelWorldSeed));
+                " chunks, seed=" + std::to_string(m_config.voxelWorldSeed) + ", " +
+                std::to_string(m_voxelWorld.LoadedChunkCount()) + " chunks in " + FormatMilliseconds(generateSeconds * 1000.0) +
+                " ms (" + std::to_string(static_cast<long long>(chunks / std::max(generateSeconds, 1e-9))) + " chunks/s, " +
+                std::to_string(JobSystem::Shared().WorkerCount() + 1) + " threads)");
     }
 
-    if (m_config.enableEditorUI)
+    if (m_config.enableEditorUI && !m_config.headless)
     {
         m_editorUI = std::make_unique<editor::EditorUI>();
         if (!m_editorUI->Initialize(
@@ -66,16 +123,7 @@ bool Engine::Initialize()
     }
 
     RegisterSystems();
-    SystemContext systemContext {
-        m_world,
-        m_inputState,
-        m_windowSystem,
-        m_renderer,
-        m_resources,
-        m_scriptHost,
-        m_editorUI.get(),
-        m_config.enableVoxelSandbox ? &m_voxelWorld : nullptr,
-        m_currentFrame + 1U};
+    SystemContext systemContext = MakeSystemContext();
 
     for (auto& system : m_systems)
     {
@@ -85,17 +133,46 @@ bool Engine::Initialize()
             return false;
         }
     }
+    m_world.FlushCommands();
+    m_simulationScheduler.Build(m_systems, SystemPhase::Simulation);
+    m_presentationScheduler.Build(m_systems, SystemPhase::Presentation);
+
+    // The first frame runs one simulation step.
+    m_accumulatorSeconds = m_config.fixedDeltaSeconds;
 
     return true;
 }
 
 void Engine::Run()
 {
+    Profiler::SetThreadName("Main");
+    if (m_config.headless)
+    {
+        RunHeadless();
+        WriteProfilerTrace();
+        Log::Flush();
+        return;
+    }
+
     Log::Write(LogLevel::Info, "Starting game loop with backend: " + std::string(m_renderer.BackendName()));
 
+    FramePacer pacer(m_config.targetFrameRate);
+    const auto runStart = FramePacer::Clock::now();
+    auto previousFrame = runStart;
     while ((m_currentFrame < m_config.maxFrames) && !m_windowSystem.ShouldClose())
     {
-        m_inputState.BeginFrame();
+        const auto frameStart = FramePacer::Clock::now();
+        if ((m_config.maxRunSeconds > 0.0) &&
+            (std::chrono::duration<double>(frameStart - runStart).count() >= m_config.maxRunSeconds))
+        {
+            break;
+        }
+
+        const double frameSeconds = std::chrono::duration<double>(frameStart - previousFrame).count();
+        previousFrame = frameStart;
+
+        // Frame memory from two frames ago is released here.
+        FrameAllocator::Shared().BeginFrame();
         m_windowSystem.PollEvents(m_inputState);
 
         if (m_inputState.WasPressed(KeyCode::Escape))
@@ -103,11 +180,76 @@ void Engine::Run()
             m_windowSystem.RequestClose();
         }
 
-        Update();
-        std::this_thread::sleep_for(std::chrono::milliseconds(16));
+        Update(frameSeconds);
+        pacer.WaitForNextFrame();
     }
 
+    m_renderer.WaitIdle();
+    // The voxel world is destroyed before the renderer.
+    m_renderer.ReleaseVoxelWorld();
     Log::Write(LogLevel::Info, "Game loop completed.");
+    WriteProfilerTrace();
+    Log::Flush();
+}
+
+void Engine::RunHeadless()
+{
+    Log::Write(LogLevel::Info, "Starting headless loop.");
+
+    // Ticks are not tied to wall time here, so every tick is exactly one step of
+    // the configured size (or a nominal 60 Hz step when the step is variable).
+    const float step = (m_config.fixedDeltaSeconds > 0.0f) ? m_config.fixedDeltaSeconds : (1.0f / 60.0f);
+    std::vector<double> systemTotalMs;
+    std::vector<double> systemMaxMs;
+    double schedulerTotalMs = 0.0;
+
+    using Clock = std::chrono::steady_clock;
+    const Clock::time_point start = Clock::now();
+    double elapsedSeconds = 0.0;
+    while (m_currentFrame < m_config.maxFrames)
+    {
+        if ((m_config.maxRunSeconds > 0.0) && (elapsedSeconds >= m_config.maxRunSeconds))
+        {
+            break;
+        }
+
+        FrameAllocator::Shared().BeginFrame();
+        SystemContext systemContext = MakeSystemContext();
+        RunSimulationStep(systemContext, step);
+        ++m_currentFrame;
+
+        const SystemFrameStats& stats = m_simulationScheduler.LastFrame();
+        systemTotalMs.resize(stats.systems.size(), 0.0);
+        systemMaxMs.resize(stats.systems.size(), 0.0);
+        for (std::size_t index = 0; index < stats.systems.size(); ++index)
+        {
+            systemTotalMs[index] += stats.systems[index].durationMs;
+            systemMaxMs[index] = std::max(systemMaxMs[index], stats.systems[index].durationMs);
+        }
+        schedulerTotalMs += stats.wallMs;
+        elapsedSeconds = std::chrono::duration<double>(Clock::now() - start).count();
+    }
+
+    const double ticks = static_cast<double>(m_currentFrame);
+    const double ticksPerSecond = (elapsedSeconds > 0.0) ? ticks / elapsedSeconds : 0.0;
+    WriteReport(
+        "Headless run: " + std::to_string(m_currentFrame) + " ticks in " + FormatMilliseconds(elapsedSeconds * 1000.0) +
+            " ms, " + std::to_string(static_cast<std::uint64_t>(ticksPerSecond)) + " ticks/s");
+    if (m_currentFrame == 0)
+    {
+        return;
+    }
+
+    WriteReport(
+        "  tick " + FormatMilliseconds(elapsedSeconds * 1000.0 / ticks) + " ms avg, systems " +
+            FormatMilliseconds(schedulerTotalMs / ticks) + " ms avg");
+    const SystemFrameStats& stats = m_simulationScheduler.LastFrame();
+    for (std::size_t index = 0; index < systemTotalMs.size(); ++index)
+    {
+        WriteReport(
+            std::string("  ") + stats.systems[index].name + ": " + FormatMilliseconds(systemTotalMs[index] / ticks) +
+                " ms avg, " + FormatMilliseconds(systemMaxMs[index]) + " ms max");
+    }
 }
 
 World& Engine::GetWorld()
@@ -115,9 +257,63 @@ World& Engine::GetWorld()
     return m_world;
 }
 
-void Engine::Update()
+void Engine::Update(const double frameSeconds)
 {
-    SystemContext systemContext {
+    RG_PROFILE_SCOPE("Engine::Update");
+    SystemContext systemContext = MakeSystemContext();
+
+    const double step = m_config.fixedDeltaSeconds;
+    if (step > 0.0)
+    {
+        // A long stall (debugger, window drag) must not turn into a burst of steps.
+        m_accumulatorSeconds += std::min(frameSeconds, kMaxFrameSeconds);
+
+        std::uint32_t steps = 0;
+        while ((m_accumulatorSeconds >= step) && (steps < m_config.maxSimulationStepsPerFrame))
+        {
+            RunSimulationStep(systemContext, static_cast<float>(step));
+            m_accumulatorSeconds -= step;
+            ++steps;
+        }
+
+        if (m_accumulatorSeconds >= step)
+        {
+            m_accumulatorSeconds = std::fmod(m_accumulatorSeconds, step);
+        }
+    }
+    else
+    {
+        RunSimulationStep(systemContext, static_cast<float>(std::min(frameSeconds, kMaxFrameSeconds)));
+    }
+
+    systemContext.lastFrameStats = &m_simulationScheduler.LastFrame();
+    m_presentationScheduler.Run(systemContext, static_cast<float>(frameSeconds));
+    m_world.FlushCommands();
+
+    if ((m_editorUI != nullptr) && m_editorUI->ConsumeCloseRequest())
+    {
+        m_windowSystem.RequestClose();
+    }
+
+    ++m_currentFrame;
+}
+
+void Engine::RunSimulationStep(SystemContext& context, const float stepSeconds)
+{
+    RG_PROFILE_SCOPE("Engine::SimulationStep");
+    m_simulationScheduler.Run(context, stepSeconds);
+
+    // Sync point for structural changes recorded during the step.
+    m_world.FlushCommands();
+
+    // Key edges (WasPressed/WasReleased) belong to the first step that sees them;
+    // when a frame runs no step they carry over to the next frame.
+    m_inputState.BeginFrame();
+}
+
+SystemContext Engine::MakeSystemContext()
+{
+    return SystemContext {
         m_world,
         m_inputState,
         m_windowSystem,
@@ -127,18 +323,27 @@ void Engine::Update()
         m_editorUI.get(),
         m_config.enableVoxelSandbox ? &m_voxelWorld : nullptr,
         m_currentFrame + 1U};
+}
 
-    for (auto& system : m_systems)
+void Engine::WriteProfilerTrace() const
+{
+    if (m_config.profilerTracePath.empty())
     {
-        system->Update(systemContext, m_config.fixedDeltaSeconds);
+        return;
     }
 
-    if ((m_editorUI != nullptr) && m_editorUI->ConsumeCloseRequest())
+#if !RG_ENABLE_PROFILER
+    Log::Write(LogLevel::Warning, "Profiler zones are compiled out (RG_ENABLE_PROFILER=0); the trace will be empty.");
+#endif
+
+    if (Profiler::WriteChromeTrace(m_config.profilerTracePath))
     {
-        m_windowSystem.RequestClose();
+        Log::Write(LogLevel::Info, "Profiler trace written: " + m_config.profilerTracePath.string());
+    }
+    else
+    {
+        Log::Write(LogLevel::Error, "Failed to write profiler trace: " + m_config.profilerTracePath.string());
     }
-
-    ++m_currentFrame;
 }
 
 void Engine::RegisterSystems()
@@ -150,6 +355,17 @@ void Engine::RegisterSystems()
     }
     m_systems.emplace_back(std::make_unique<ScriptSystem>());
     m_systems.emplace_back(std::make_unique<PhysicsSystem>());
-    m_systems.emplace_back(std::make_unique<RenderSystem>());
+    if (!m_config.headless)
+    {
+        if (m_config.enableVoxelSandbox && m_config.voxelStreaming)
+        {
+            minecraft::VoxelStreamingSettings settings;
+            settings.viewDistanceInChunks = m_config.voxelWorldRadiusInChunks;
+            settings.memoryBudgetBytes = m_config.voxelStreamingMemoryBudgetBytes;
+            settings.frameBudgetMs = m_config.voxelStreamingBudgetMs;
+            m_systems.emplace_back(std::make_unique<VoxelStreamingSystem>(settings));
+        }
+        m_systems.emplace_back(std::make_unique<RenderSystem>());
+    }
 }
 } // namespace rg
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 #include <filesystem>
 #include <memory>
@@ -15,6 +16,8 @@
 #include "Engine/Scene/World.h"
 #include "Engine/Scripting/ScriptHost.h"
 #include "Engine/Systems/ISystem.h"
+#include "Engine/Systems/SystemContext.h"
+#include "Engine/Systems/SystemScheduler.h"
 #include "Game/Minecraft/VoxelWorld.h"
 
 namespace rg
@@ -25,13 +28,41 @@ struct EngineConfig
     WindowSpec window {};
     RenderAPI renderAPI = RenderAPI::DirectX12;
     bool vsync = true;
+    // Draw frame N on a render thread while frame N+1 simulates (editor frames are
+    // still drawn on the main thread).
+    bool renderThread = true;
     bool enableEditorUI = true;
     bool enableVoxelSandbox = true;
     int voxelWorldRadiusInChunks = 8;
     int voxelWorldSeed = 1337;
+    // Stream chunks in a ring of voxelWorldRadiusInChunks around the player instead
+    // of generating a fixed square at startup. Ignored in headless mode.
+    bool voxelStreaming = false;
+    std::size_t voxelStreamingMemoryBudgetBytes = std::size_t {64} << 20U;
+    // Main-thread time per frame for moving streamed chunks into the world.
+    double voxelStreamingBudgetMs = 2.0;
     std::filesystem::path assetRoot = "assets";
     std::uint32_t maxFrames = 120;
+    // Simulation step. Simulation systems run as many fixed steps per frame as the
+    // elapsed time calls for; <= 0 runs one variable step per frame instead.
     float fixedDeltaSeconds = 1.0f / 60.0f;
+    // Frame rate the main loop is paced to; <= 0 runs uncapped (benchmarking).
+    float targetFrameRate = 60.0f;
+    // Upper bound on simulation steps per frame. When a frame falls further behind,
+    // the excess time is dropped instead of simulating ever more steps.
+    std::uint32_t maxSimulationStepsPerFrame = 5;
+    // Server/benchmark mode: no window, renderer, editor or presentation systems.
+    // The loop runs uncapped, one simulation step per tick, and prints throughput
+    // (ticks/s, per-system ms) when it ends.
+    bool headless = false;
+    // Wall-clock limit for Run() in seconds, checked alongside maxFrames; <= 0 means
+    // no limit.
+    double maxRunSeconds = 0.0;
+    // When set, Run() writes the profiler zones it captured to this file as a Chrome
+    // trace (chrome://tracing, Perfetto) when it ends.
+    std::filesystem::path profilerTracePath;
+    // When set, log output is also written to this file.
+    std::filesystem::path logFilePath;
 };
 
 class Engine
@@ -46,10 +77,15 @@ public:
 
 private:
     void RegisterSystems();
-    void Update();
+    void RunHeadless();
+    void Update(double frameSeconds);
+    void RunSimulationStep(SystemContext& context, float stepSeconds);
+    [[nodiscard]] SystemContext MakeSystemContext();
+    void WriteProfilerTrace() const;
 
     EngineConfig m_config;
     std::uint32_t m_currentFrame = 0;
+    double m_accumulatorSeconds = 0.0;
     InputState m_inputState;
     WindowSystem m_windowSystem;
     ResourceManager m_resources;
@@ -59,5 +95,7 @@ private:
     minecraft::VoxelWorld m_voxelWorld;
     std::unique_ptr<editor::EditorUI> m_editorUI;
     std::vector<std::unique_ptr<ISystem>> m_systems;
+    SystemScheduler m_simulationScheduler;
+    SystemScheduler m_presentationScheduler;
 };
 } // namespace rg
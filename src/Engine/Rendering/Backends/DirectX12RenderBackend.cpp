@@ -17,15 +17,9 @@ bool DirectX12RenderBackend::Initialize(ResourceManager& resources, const Render
     return false;
 }
 
-void DirectX12RenderBackend::Render(
-    const World& world,
-    const minecraft::VoxelWorld* voxelWorld,
-    const std::uint64_t frameIndex,
-    const UiRenderCallback& uiCallback)
+void DirectX12RenderBackend::Render(const RenderPacket& packet, const UiRenderCallback& uiCallback)
 {
-    (void)world;
-    (void)voxelWorld;
-    (void)frameIndex;
+    (void)packet;
     (void)uiCallback;
 }
 
@@ -33,6 +27,11 @@ const char* DirectX12RenderBackend::Name() const
 {
     return "DirectX12";
 }
+
+bool DirectX12RenderBackend::WantsChunkMeshes() const
+{
+    return false;
+}
 } // namespace rg
 
 #else
@@ -60,9 +59,6 @@ const char* DirectX12RenderBackend::Name() const
 #include <DirectXMath.h>
 
 #include "Engine/Core/Log.h"
-#include "Engine/Scene/Components.h"
-#include "Game/Minecraft/VoxelMesher.h"
-#include "Game/Minecraft/VoxelWorld.h"
 
 #if defined(RG_WITH_IMGUI) && RG_WITH_IMGUI
 #include <backends/imgui_impl_dx12.h>
@@ -170,8 +166,11 @@ struct DirectX12RenderBackend::Impl
     [[nodiscard]] bool BeginFrame();
     [[nodiscard]] bool EndFrame();
     [[nodiscard]] bool CreateVoxelPipeline();
-    [[nodiscard]] bool RebuildChunkMeshes(const minecraft::VoxelWorld& world);
-    void DrawVoxelWorld(const World& world);
+    // Packets carry only the chunks that changed, so their meshes are queued until
+    // a frame can apply them; a failed frame must not lose them.
+    void QueueChunkMeshes(const RenderPacket& packet);
+    [[nodiscard]] bool ApplyChunkMeshes();
+    void DrawVoxelWorld(const RenderCamera& camera);
     void DrawEditorUi(const UiRenderCallback& uiCallback);
 
 private:
@@ -183,8 +182,9 @@ private:
         const char* entryPoint,
         const char* profile,
         Microsoft::WRL::ComPtr<ID3DBlob>& outBlob) const;
+    [[nodiscard]] bool UploadChunkMesh(const minecraft::VoxelChunkMesh& mesh, ChunkGpuMesh& outMesh) const;
     void BuildCamera(
-        const World& world,
+        const RenderCamera& camera,
         DirectX::XMMATRIX& outView,
         DirectX::XMMATRIX& outProj,
         DirectX::BoundingFrustum& outWorldFrustum) const;
@@ -218,6 +218,10 @@ public:
 
     std::uint64_t voxelRevision = 0;
     std::vector<ChunkGpuMesh> chunkMeshes;
+    // Latest queued mesh per chunk, and whether the GPU meshes start over first.
+    std::vector<minecraft::VoxelChunkMesh> pendingChunkMeshes;
+    bool pendingReset = false;
+    std::uint64_t pendingRevision = 0;
 
 #if defined(RG_WITH_IMGUI) && RG_WITH_IMGUI
     ComPtr<ID3D12DescriptorHeap> imguiSrvHeap;
@@ -765,85 +769,139 @@ bool DirectX12RenderBackend::Impl::CreateUploadBuffer(
     return true;
 }
 
-bool DirectX12RenderBackend::Impl::RebuildChunkMeshes(const minecraft::VoxelWorld& world)
+bool DirectX12RenderBackend::Impl::UploadChunkMesh(const minecraft::VoxelChunkMesh& mesh, ChunkGpuMesh& outMesh) const
 {
-    chunkMeshes.clear();
-    chunkMeshes.reserve(world.LoadedChunkCount());
+    const std::size_t vertexBytes = mesh.vertices.size() * sizeof(minecraft::VoxelVertex);
+    const std::size_t indexBytes = mesh.indices.size() * sizeof(std::uint32_t);
+    if ((vertexBytes > std::numeric_limits<UINT>::max()) || (indexBytes > std::numeric_limits<UINT>::max()))
+    {
+        return false;
+    }
 
-    std::size_t totalTriangles = 0;
-    const auto chunks = world.ChunkCoordinates();
-    for (const auto& [chunkX, chunkZ] : chunks)
+    outMesh.chunkX = mesh.chunkX;
+    outMesh.chunkZ = mesh.chunkZ;
+    outMesh.indexCount = static_cast<std::uint32_t>(mesh.indices.size());
+    outMesh.boundsMin = {mesh.boundsMin.x, mesh.boundsMin.y, mesh.boundsMin.z};
+    outMesh.boundsMax = {mesh.boundsMax.x, mesh.boundsMax.y, mesh.boundsMax.z};
+
+    if (!CreateUploadBuffer(mesh.vertices.data(), vertexBytes, outMesh.vertexBuffer))
     {
-        minecraft::VoxelChunkMesh mesh = minecraft::VoxelMesher::BuildChunkMesh(world, chunkX, chunkZ);
-        if (mesh.indices.empty())
+        return false;
+    }
+    if (!CreateUploadBuffer(mesh.indices.data(), indexBytes, outMesh.indexBuffer))
+    {
+        return false;
+    }
+
+    outMesh.vertexView.BufferLocation = outMesh.vertexBuffer->GetGPUVirtualAddress();
+    outMesh.vertexView.StrideInBytes = sizeof(minecraft::VoxelVertex);
+    outMesh.vertexView.SizeInBytes = static_cast<UINT>(vertexBytes);
+
+    outMesh.indexView.BufferLocation = outMesh.indexBuffer->GetGPUVirtualAddress();
+    outMesh.indexView.Format = DXGI_FORMAT_R32_UINT;
+    outMesh.indexView.SizeInBytes = static_cast<UINT>(indexBytes);
+    return true;
+}
+
+void DirectX12RenderBackend::Impl::QueueChunkMeshes(const RenderPacket& packet)
+{
+    pendingRevision = packet.voxelRevision;
+    if (packet.resetChunkMeshes)
+    {
+        pendingChunkMeshes.clear();
+        pendingReset = true;
+    }
+
+    for (const minecraft::VoxelChunkMesh& mesh : packet.chunkMeshes)
+    {
+        const auto it = std::find_if(
+            pendingChunkMeshes.begin(),
+            pendingChunkMeshes.end(),
+            [&mesh](const minecraft::VoxelChunkMesh& queued)
+            {
+                return (queued.chunkX == mesh.chunkX) && (queued.chunkZ == mesh.chunkZ);
+            });
+        if (it != pendingChunkMeshes.end())
         {
-            continue;
+            *it = mesh;
         }
-
-        const std::size_t vertexBytes = mesh.vertices.size() * sizeof(minecraft::VoxelVertex);
-        const std::size_t indexBytes = mesh.indices.size() * sizeof(std::uint32_t);
-        if ((vertexBytes > std::numeric_limits<UINT>::max()) || (indexBytes > std::numeric_limits<UINT>::max()))
+        else
         {
-            continue;
+            pendingChunkMeshes.push_back(mesh);
         }
+    }
+}
 
-        ChunkGpuMesh gpuMesh;
-        gpuMesh.chunkX = chunkX;
-        gpuMesh.chunkZ = chunkZ;
-        gpuMesh.indexCount = static_cast<std::uint32_t>(mesh.indices.size());
-        gpuMesh.boundsMin = {mesh.boundsMin.x, mesh.boundsMin.y, mesh.boundsMin.z};
-        gpuMesh.boundsMax = {mesh.boundsMax.x, mesh.boundsMax.y, mesh.boundsMax.z};
+bool DirectX12RenderBackend::Impl::ApplyChunkMeshes()
+{
+    if (!pendingReset && pendingChunkMeshes.empty())
+    {
+        return true;
+    }
+
+    // Replaced buffers may still be referenced by frames in flight.
+    WaitForGpu();
 
-        if (!CreateUploadBuffer(mesh.vertices.data(), vertexBytes, gpuMesh.vertexBuffer))
+    if (pendingReset)
+    {
+        chunkMeshes.clear();
+        chunkMeshes.reserve(pendingChunkMeshes.size());
+    }
+
+    for (const minecraft::VoxelChunkMesh& mesh : pendingChunkMeshes)
+    {
+        // A changed chunk replaces its previous mesh; an empty one just removes it.
+        chunkMeshes.erase(
+            std::remove_if(
+                chunkMeshes.begin(),
+                chunkMeshes.end(),
+                [&mesh](const ChunkGpuMesh& existing)
+                {
+                    return (existing.chunkX == mesh.chunkX) && (existing.chunkZ == mesh.chunkZ);
+                }),
+            chunkMeshes.end());
+        if (mesh.indices.empty())
         {
             continue;
         }
-        if (!CreateUploadBuffer(mesh.indices.data(), indexBytes, gpuMesh.indexBuffer))
+
+        ChunkGpuMesh gpuMesh;
+        if (UploadChunkMesh(mesh, gpuMesh))
         {
-            continue;
+            chunkMeshes.push_back(std::move(gpuMesh));
         }
+    }
 
-        gpuMesh.vertexView.BufferLocation = gpuMesh.vertexBuffer->GetGPUVirtualAddress();
-        gpuMesh.vertexView.StrideInBytes = sizeof(minecraft::VoxelVertex);
-        gpuMesh.vertexView.SizeInBytes = static_cast<UINT>(vertexBytes);
-
-        gpuMesh.indexView.BufferLocation = gpuMesh.indexBuffer->GetGPUVirtualAddress();
-        gpuMesh.indexView.Format = DXGI_FORMAT_R32_UINT;
-        gpuMesh.indexView.SizeInBytes = static_cast<UINT>(indexBytes);
-
-        totalTriangles += (mesh.indices.size() / 3U);
-        chunkMeshes.push_back(std::move(gpuMesh));
+    std::size_t totalTriangles = 0;
+    for (const ChunkGpuMesh& mesh : chunkMeshes)
+    {
+        totalTriangles += mesh.indexCount / 3U;
     }
 
-    voxelRevision = world.Revision();
+    const std::size_t uploaded = pendingChunkMeshes.size();
+    pendingChunkMeshes.clear();
+    pendingReset = false;
+    voxelRevision = pendingRevision;
     Log::Write(
         LogLevel::Info,
-        "[DirectX12] Rebuilt voxel meshes: chunks=" + std::to_string(chunkMeshes.size()) +
-            ", triangles=" + std::to_string(totalTriangles));
+        "[DirectX12] Updated voxel meshes: uploaded=" + std::to_string(uploaded) +
+            ", chunks=" + std::to_string(chunkMeshes.size()) + ", triangles=" + std::to_string(totalTriangles));
     return true;
 }
 
 void DirectX12RenderBackend::Impl::BuildCamera(
-    const World& world,
+    const RenderCamera& camera,
     DirectX::XMMATRIX& outView,
     DirectX::XMMATRIX& outProj,
     DirectX::BoundingFrustum& outWorldFrustum) const
 {
     DirectX::XMFLOAT3 cameraPos {0.0f, 46.0f, -64.0f};
     DirectX::XMFLOAT3 cameraDir {0.25f, -0.35f, 1.0f};
-    bool hasPlayer = false;
-
-    world.ForEach<VoxelPlayerComponent, TransformComponent>([&](Entity /*entity*/, const VoxelPlayerComponent&, const TransformComponent& transform)
+    if (camera.valid)
     {
-        if (hasPlayer)
-        {
-            return;
-        }
-
-        cameraPos = {transform.position.x, transform.position.y + 1.7f, transform.position.z};
-        cameraDir = {0.0f, -0.2f, 1.0f};
-        hasPlayer = true;
-    });
+        cameraPos = {camera.position.x, camera.position.y, camera.position.z};
+        cameraDir = {camera.direction.x, camera.direction.y, camera.direction.z};
+    }
 
     const DirectX::XMVECTOR eye = DirectX::XMVectorSet(cameraPos.x, cameraPos.y, cameraPos.z, 1.0f);
     const DirectX::XMVECTOR direction =
@@ -861,7 +919,7 @@ void DirectX12RenderBackend::Impl::BuildCamera(
     viewFrustum.Transform(outWorldFrustum, invView);
 }
 
-void DirectX12RenderBackend::Impl::DrawVoxelWorld(const World& world)
+void DirectX12RenderBackend::Impl::DrawVoxelWorld(const RenderCamera& camera)
 {
     if ((pipelineState == nullptr) || (rootSignature == nullptr) || (mappedFrameConstants == nullptr))
     {
@@ -871,7 +929,7 @@ void DirectX12RenderBackend::Impl::DrawVoxelWorld(const World& world)
     DirectX::XMMATRIX view;
     DirectX::XMMATRIX proj;
     DirectX::BoundingFrustum worldFrustum;
-    BuildCamera(world, view, proj, worldFrustum);
+    BuildCamera(camera, view, proj, worldFrustum);
 
     DirectX::XMStoreFloat4x4(&mappedFrameConstants->viewProj, DirectX::XMMatrixTranspose(view * proj));
 
@@ -1032,19 +1090,18 @@ bool DirectX12RenderBackend::Initialize(ResourceManager& resources, const Render
     return true;
 }
 
-void DirectX12RenderBackend::Render(
-    const World& world,
-    const minecraft::VoxelWorld* voxelWorld,
-    const std::uint64_t frameIndex,
-    const UiRenderCallback& uiCallback)
+void DirectX12RenderBackend::Render(const RenderPacket& packet, const UiRenderCallback& uiCallback)
 {
-    (void)frameIndex;
-
     if (m_impl == nullptr)
     {
         return;
     }
 
+    if (packet.hasVoxelWorld)
+    {
+        m_impl->QueueChunkMeshes(packet);
+    }
+
     if (!m_impl->BeginFrame())
     {
         if (!m_reportedRenderFailure)
@@ -1055,16 +1112,13 @@ void DirectX12RenderBackend::Render(
         return;
     }
 
-    if (m_pipelineReady && (voxelWorld != nullptr))
+    if (m_pipelineReady && packet.hasVoxelWorld)
     {
-        if (voxelWorld->Revision() != m_impl->voxelRevision)
+        if (!m_impl->ApplyChunkMeshes())
         {
-            if (!m_impl->RebuildChunkMeshes(*voxelWorld))
-            {
-                m_pipelineReady = false;
-            }
+            m_pipelineReady = false;
         }
-        m_impl->DrawVoxelWorld(world);
+        m_impl->DrawVoxelWorld(packet.camera);
     }
 
     m_impl->DrawEditorUi(uiCallback);
@@ -1086,6 +1140,12 @@ const char* DirectX12RenderBackend::Name() const
 {
     return "DirectX12";
 }
+
+bool DirectX12RenderBackend::WantsChunkMeshes() const
+{
+    // Constant so the simulation thread can ask while a packet is being drawn.
+    return true;
+}
 } // namespace rg
 
 #endif
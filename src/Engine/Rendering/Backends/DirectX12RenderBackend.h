@@ -13,12 +13,9 @@ public:
     ~DirectX12RenderBackend() override;
 
     bool Initialize(ResourceManager& resources, const RenderBackendContext& context) override;
-    void Render(
-        const World& world,
-        const minecraft::VoxelWorld* voxelWorld,
-        std::uint64_t frameIndex,
-        const UiRenderCallback& uiCallback) override;
+    void Render(const RenderPacket& packet, const UiRenderCallback& uiCallback) override;
     [[nodiscard]] const char* Name() const override;
+    [[nodiscard]] bool WantsChunkMeshes() const override;
 
 private:
     struct Impl;
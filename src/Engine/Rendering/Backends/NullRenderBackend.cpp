@@ -1,10 +1,8 @@
 #include "Engine/Rendering/Backends/NullRenderBackend.h"
 
-#include <iomanip>
-#include <sstream>
+#include <cstdio>
 
 #include "Engine/Core/Log.h"
-#include "Engine/Scene/Components.h"
 
 namespace rg
 {
@@ -17,36 +15,42 @@ bool NullRenderBackend::Initialize(ResourceManager& resources, const RenderBacke
     return true;
 }
 
-void NullRenderBackend::Render(
-    const World& world,
-    const minecraft::VoxelWorld* voxelWorld,
-    const std::uint64_t frameIndex,
-    const UiRenderCallback& uiCallback)
+void NullRenderBackend::Render(const RenderPacket& packet, const UiRenderCallback& uiCallback)
 {
-    (void)voxelWorld;
     (void)uiCallback;
-    std::ostringstream oss;
-    oss << "[NullRenderer] Frame " << frameIndex
-        << " | entities=" << world.EntityCount()
-        << " | cachedShaderBytes=" << m_cachedShaderBytes
-        << " | scene=";
-
-    bool first = true;
-    world.ForEach<NameComponent, TransformComponent>([&](Entity /*entity*/, const NameComponent& name, const TransformComponent& transform)
+    // The scene dump is Info-level; nothing is built when Info is compiled out.
+    if constexpr (Log::IsEnabled(LogLevel::Info))
     {
-        if (!first)
+        char number[96];
+        std::snprintf(
+            number,
+            sizeof(number),
+            "[NullRenderer] Frame %llu | entities=%zu | cachedShaderBytes=%zu | scene=",
+            static_cast<unsigned long long>(packet.frameIndex),
+            packet.entityCount,
+            m_cachedShaderBytes);
+        m_line = number;
+
+        for (std::size_t index = 0; index < packet.instanceCount; ++index)
         {
-            oss << ", ";
+            const RenderInstance& instance = packet.instances[index];
+            if (index > 0)
+            {
+                m_line += ", ";
+            }
+
+            const auto& p = instance.transform.position;
+            std::snprintf(number, sizeof(number), " pos(%.2f, %.2f, %.2f)", p.x, p.y, p.z);
+            m_line += instance.name;
+            m_line += number;
         }
-        first = false;
 
-        const auto& p = transform.position;
-        oss << name.value << " pos("
-            << std::fixed << std::setprecision(2)
-            << p.x << ", " << p.y << ", " << p.z << ")";
-    });
-
-    Log::Write(LogLevel::Info, oss.str());
+        Log::Write(LogLevel::Info, m_line);
+    }
+    else
+    {
+        (void)packet;
+    }
 }
 
 const char* NullRenderBackend::Name() const
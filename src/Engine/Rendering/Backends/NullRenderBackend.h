@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cstddef>
+#include <string>
 
 #include "Engine/Rendering/IRenderBackend.h"
 
@@ -10,14 +11,12 @@ class NullRenderBackend final : public IRenderBackend
 {
 public:
     bool Initialize(ResourceManager& resources, const RenderBackendContext& context) override;
-    void Render(
-        const World& world,
-        const minecraft::VoxelWorld* voxelWorld,
-        std::uint64_t frameIndex,
-        const UiRenderCallback& uiCallback) override;
+    void Render(const RenderPacket& packet, const UiRenderCallback& uiCallback) override;
     [[nodiscard]] const char* Name() const override;
 
 private:
     std::size_t m_cachedShaderBytes = 0;
+    // Reused every frame so the per-frame line does not allocate.
+    std::string m_line;
 };
 } // namespace rg
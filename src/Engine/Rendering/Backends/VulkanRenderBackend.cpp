@@ -3,7 +3,6 @@
 #include <sstream>
 
 #include "Engine/Core/Log.h"
-#include "Engine/Scene/Components.h"
 
 namespace rg
 {
@@ -26,26 +25,21 @@ bool VulkanRenderBackend::Initialize(ResourceManager& resources, const RenderBac
     return true;
 }
 
-void VulkanRenderBackend::Render(
-    const World& world,
-    const minecraft::VoxelWorld* voxelWorld,
-    const std::uint64_t frameIndex,
-    const UiRenderCallback& uiCallback)
+void VulkanRenderBackend::Render(const RenderPacket& packet, const UiRenderCallback& uiCallback)
 {
-    (void)voxelWorld;
     (void)uiCallback;
     std::size_t drawCalls = 0;
-    world.ForEach<MeshComponent, TransformComponent>([&](Entity /*entity*/, const MeshComponent& mesh, const TransformComponent& /*transform*/)
+    for (std::size_t index = 0; index < packet.instanceCount; ++index)
     {
-        if (mesh.visible)
+        if (packet.instances[index].meshVisible)
         {
             ++drawCalls;
         }
-    });
+    }
 
     std::ostringstream oss;
-    oss << "[Vulkan] Frame " << frameIndex
-        << " | entities=" << world.EntityCount()
+    oss << "[Vulkan] Frame " << packet.frameIndex
+        << " | entities=" << packet.entityCount
         << " | drawCalls=" << drawCalls
         << " | pipeline=" << (m_pipelineReady ? "ready" : "stub");
     Log::Write(LogLevel::Info, oss.str());
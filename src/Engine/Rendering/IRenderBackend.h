@@ -3,16 +3,11 @@
 #include <cstdint>
 #include <functional>
 
+#include "Engine/Rendering/RenderPacket.h"
 #include "Engine/Resources/ResourceManager.h"
-#include "Engine/Scene/World.h"
 
 namespace rg
 {
-namespace minecraft
-{
-class VoxelWorld;
-}
-
 struct RenderBackendContext
 {
     void* nativeWindowHandle = nullptr;
@@ -29,11 +24,16 @@ public:
     virtual ~IRenderBackend() = default;
 
     virtual bool Initialize(ResourceManager& resources, const RenderBackendContext& context) = 0;
-    virtual void Render(
-        const World& world,
-        const minecraft::VoxelWorld* voxelWorld,
-        std::uint64_t frameIndex,
-        const UiRenderCallback& uiCallback) = 0;
+    // Draws one extracted frame. Runs on the render thread unless uiCallback is
+    // set, in which case it runs on the simulation thread.
+    virtual void Render(const RenderPacket& packet, const UiRenderCallback& uiCallback) = 0;
     [[nodiscard]] virtual const char* Name() const = 0;
+
+    // Whether packets should carry voxel chunk meshes. Meshing is skipped for
+    // backends that do not draw the voxel world.
+    [[nodiscard]] virtual bool WantsChunkMeshes() const
+    {
+        return false;
+    }
 };
 } // namespace rg
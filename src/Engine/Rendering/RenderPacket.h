@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "Engine/ECS/EntityId.h"
+#include "Engine/Math/Vector3.h"
+#include "Engine/Scene/Components.h"
+#include "Game/Minecraft/VoxelMesher.h"
+
+namespace rg
+{
+struct RenderCamera
+{
+    // False when the scene has no camera source; backends use their default view.
+    bool valid = false;
+    Vector3 position {};
+    Vector3 direction {0.0f, 0.0f, 1.0f};
+};
+
+// One entity as the backend sees it: a copy of its transform plus what it draws.
+struct RenderInstance
+{
+    ecs::EntityId entity = ecs::InvalidEntity;
+    std::string name;
+    TransformComponent transform {};
+    bool hasMesh = false;
+    bool meshVisible = false;
+    std::string meshAsset;
+    std::string materialAsset;
+};
+
+// Everything a backend needs to draw one frame, copied out of the World and
+// VoxelWorld by Renderer on the simulation thread. Backends never see live
+// simulation state, so a packet can be drawn while the next frame simulates.
+struct RenderPacket
+{
+    std::uint64_t frameIndex = 0;
+    std::size_t entityCount = 0;
+    RenderCamera camera;
+    // instanceCount entries are valid; the rest keep their string capacity for
+    // reuse by later frames.
+    std::vector<RenderInstance> instances;
+    std::size_t instanceCount = 0;
+
+    bool hasVoxelWorld = false;
+    std::uint64_t voxelRevision = 0;
+    // When set, the backend drops every chunk mesh it holds before applying
+    // chunkMeshes (the world was regenerated or the backend is new).
+    bool resetChunkMeshes = false;
+    // Chunks whose geometry changed since the previous packet. An empty mesh
+    // means the chunk has nothing to draw any more.
+    std::vector<minecraft::VoxelChunkMesh> chunkMeshes;
+};
+} // namespace rg
@@ -1,12 +1,17 @@
 #include "Engine/Rendering/Renderer.h"
 
+#include <algorithm>
+#include <exception>
 #include <memory>
 #include <string>
 
+#include "Engine/Core/JobSystem.h"
 #include "Engine/Core/Log.h"
+#include "Engine/Core/Profiler.h"
 #include "Engine/Rendering/Backends/DirectX12RenderBackend.h"
 #include "Engine/Rendering/Backends/NullRenderBackend.h"
 #include "Engine/Rendering/Backends/VulkanRenderBackend.h"
+#include "Game/Minecraft/VoxelWorld.h"
 
 namespace rg
 {
@@ -27,8 +32,15 @@ std::unique_ptr<IRenderBackend> CreateBackend(const RenderAPI api)
 }
 } // namespace
 
+Renderer::~Renderer()
+{
+    StopRenderThread();
+    ReleaseWorld();
+}
+
 bool Renderer::Initialize(const RendererConfig& config, ResourceManager& resources, const RenderBackendContext& context)
 {
+    StopRenderThread();
     m_backend = CreateBackend(config.api);
     if (m_backend == nullptr)
     {
@@ -42,16 +54,32 @@ bool Renderer::Initialize(const RendererConfig& config, ResourceManager& resourc
     {
         Log::Write(LogLevel::Warning, "Requested renderer backend failed. Falling back to Null backend.");
         m_backend = std::make_unique<NullRenderBackend>();
-        return m_backend->Initialize(resources, backendContext);
+        if (!m_backend->Initialize(resources, backendContext))
+        {
+            return false;
+        }
+    }
+    else
+    {
+        Log::Write(LogLevel::Info, std::string("Renderer backend: ") + m_backend->Name());
     }
 
-    Log::Write(LogLevel::Info, std::string("Renderer backend: ") + m_backend->Name());
+    m_trackedWorld = nullptr;
+    m_meshedChunks.clear();
+    if (config.renderThread)
+    {
+        m_stop = false;
+        m_renderThread = std::thread([this]()
+        {
+            RenderThreadLoop();
+        });
+    }
     return true;
 }
 
 void Renderer::Render(
-    const World& world,
-    const minecraft::VoxelWorld* voxelWorld,
+    World& world,
+    minecraft::VoxelWorld* voxelWorld,
     const UiRenderCallback& uiCallback)
 {
     if (m_backend == nullptr)
@@ -59,12 +87,362 @@ void Renderer::Render(
         return;
     }
 
+    // The render thread may still be drawing the other packet.
+    RenderPacket& packet = m_packets[m_writeIndex];
     ++m_frameIndex;
-    m_backend->Render(world, voxelWorld, m_frameIndex, uiCallback);
+    Extract(world, voxelWorld, packet);
+    m_writeIndex = 1U - m_writeIndex;
+
+    // UI code builds its draw data from live world state, so those frames are
+    // drawn here after the render thread has caught up.
+    if (!m_renderThread.joinable() || uiCallback)
+    {
+        WaitIdle();
+        DrawPacket(packet, uiCallback);
+        return;
+    }
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_signal.wait(lock, [this]()
+    {
+        return (m_pending == nullptr) && !m_drawing;
+    });
+    m_pending = &packet;
+    lock.unlock();
+    m_signal.notify_all();
+}
+
+void Renderer::WaitIdle()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_signal.wait(lock, [this]()
+    {
+        return (m_pending == nullptr) && !m_drawing;
+    });
+}
+
+void Renderer::ReleaseVoxelWorld()
+{
+    if (m_trackedWorld != nullptr)
+    {
+        m_trackedWorld->UnregisterDirtyTracker(m_dirtyTracker);
+        m_trackedWorld = nullptr;
+    }
+    m_meshedChunks.clear();
 }
 
 const char* Renderer::BackendName() const
 {
     return m_backend ? m_backend->Name() : "None";
 }
+
+void Renderer::Extract(World& world, minecraft::VoxelWorld* voxelWorld, RenderPacket& packet)
+{
+    RG_PROFILE_SCOPE("Renderer::Extract");
+    packet.frameIndex = m_frameIndex;
+    packet.entityCount = world.EntityCount();
+
+    packet.camera = RenderCamera {};
+    world.ForEach<VoxelPlayerComponent, TransformComponent>([&packet](Entity /*entity*/, const VoxelPlayerComponent&, const TransformComponent& transform)
+    {
+        if (packet.camera.valid)
+        {
+            return;
+        }
+
+        packet.camera.valid = true;
+        packet.camera.position = {transform.position.x, transform.position.y + VoxelPlayerComponent::kEyeHeight, transform.position.z};
+        packet.camera.direction = VoxelPlayerComponent::kViewDirection;
+    });
+
+    ExtractInstances(world, packet);
+    ExtractChunkMeshes(voxelWorld, packet);
+}
+
+void Renderer::ExtractInstances(World& world, RenderPacket& packet)
+{
+    auto& registry = world.GetRegistry();
+    if (&world != m_instanceWorld)
+    {
+        // Starting from version 0 reports every component, which fills the rows.
+        ReleaseWorld();
+        m_instanceWorld = &world;
+        registry.AddObserver<NameComponent>(&m_instanceObserver);
+        registry.AddObserver<TransformComponent>(&m_instanceObserver);
+        registry.AddObserver<MeshComponent>(&m_instanceObserver);
+        m_packetNeedsFullSync[0] = true;
+        m_packetNeedsFullSync[1] = true;
+    }
+
+    // Entities without a row are refreshed below: they may have just gained the
+    // components an instance needs.
+    m_transformVersion = registry.ForEachChanged<TransformComponent>(m_transformVersion,
+        [this](const ecs::EntityId id, const TransformComponent& transform)
+        {
+            const auto row = m_instanceRows.find(id);
+            if (row == m_instanceRows.end())
+            {
+                m_staleInstances.push_back(id);
+                return;
+            }
+            m_instances[row->second].transform = transform;
+            m_dirtyRows.push_back(row->second);
+        });
+    m_nameVersion = registry.ForEachChanged<NameComponent>(m_nameVersion,
+        [this](const ecs::EntityId id, const NameComponent& name)
+        {
+            const auto row = m_instanceRows.find(id);
+            if (row == m_instanceRows.end())
+            {
+                m_staleInstances.push_back(id);
+                return;
+            }
+            m_instances[row->second].name = name.value;
+            m_dirtyRows.push_back(row->second);
+        });
+    m_meshVersion = registry.ForEachChanged<MeshComponent>(m_meshVersion,
+        [this](const ecs::EntityId id, const MeshComponent& /*mesh*/)
+        {
+            m_staleInstances.push_back(id);
+        });
+
+    for (const ecs::EntityId id : m_staleInstances)
+    {
+        RefreshInstance(registry, id);
+    }
+    m_staleInstances.clear();
+
+    // The packet holds the rows as of its previous extraction, two frames ago;
+    // only rows written since then are copied. Strings keep their capacity.
+    const std::size_t count = m_instances.size();
+    if (packet.instances.size() < count)
+    {
+        packet.instances.resize(count);
+    }
+    bool& fullSync = m_packetNeedsFullSync[m_writeIndex];
+    if (fullSync)
+    {
+        std::copy(m_instances.begin(), m_instances.end(), packet.instances.begin());
+        fullSync = false;
+    }
+    else
+    {
+        for (const std::vector<std::size_t>* rows : {&m_previousDirtyRows, &m_dirtyRows})
+        {
+            for (const std::size_t row : *rows)
+            {
+                if (row < count)
+                {
+                    packet.instances[row] = m_instances[row];
+                }
+            }
+        }
+    }
+    packet.instanceCount = count;
+    m_previousDirtyRows.swap(m_dirtyRows);
+    m_dirtyRows.clear();
+}
+
+void Renderer::RefreshInstance(const ecs::Registry& registry, const ecs::EntityId id)
+{
+    if (!registry.IsAlive(id) || !registry.HasComponent<NameComponent>(id) || !registry.HasComponent<TransformComponent>(id))
+    {
+        RemoveInstance(id);
+        return;
+    }
+
+    const auto [row, inserted] = m_instanceRows.try_emplace(id, m_instances.size());
+    if (inserted)
+    {
+        m_instances.emplace_back();
+    }
+
+    RenderInstance& instance = m_instances[row->second];
+    instance.entity = id;
+    instance.name = registry.GetComponent<NameComponent>(id).value;
+    instance.transform = registry.GetComponent<TransformComponent>(id);
+    const MeshComponent* mesh = registry.HasComponent<MeshComponent>(id) ? &registry.GetComponent<MeshComponent>(id) : nullptr;
+    instance.hasMesh = (mesh != nullptr);
+    instance.meshVisible = (mesh != nullptr) && mesh->visible;
+    if (mesh != nullptr)
+    {
+        instance.meshAsset = mesh->meshAsset;
+        instance.materialAsset = mesh->materialAsset;
+    }
+    else
+    {
+        instance.meshAsset.clear();
+        instance.materialAsset.clear();
+    }
+    m_dirtyRows.push_back(row->second);
+}
+
+void Renderer::RemoveInstance(const ecs::EntityId id)
+{
+    const auto row = m_instanceRows.find(id);
+    if (row == m_instanceRows.end())
+    {
+        return;
+    }
+
+    // Swap-and-pop; swapping keeps the string capacity of both rows.
+    const std::size_t index = row->second;
+    const std::size_t last = m_instances.size() - 1;
+    m_instanceRows.erase(row);
+    if (index != last)
+    {
+        std::swap(m_instances[index], m_instances[last]);
+        m_instanceRows[m_instances[index].entity] = index;
+        m_dirtyRows.push_back(index);
+    }
+    m_instances.pop_back();
+}
+
+void Renderer::ReleaseWorld()
+{
+    if (m_instanceWorld != nullptr)
+    {
+        auto& registry = m_instanceWorld->GetRegistry();
+        registry.RemoveObserver<NameComponent>(&m_instanceObserver);
+        registry.RemoveObserver<TransformComponent>(&m_instanceObserver);
+        registry.RemoveObserver<MeshComponent>(&m_instanceObserver);
+        m_instanceWorld = nullptr;
+    }
+    m_instances.clear();
+    m_instanceRows.clear();
+    m_staleInstances.clear();
+    m_dirtyRows.clear();
+    m_previousDirtyRows.clear();
+    m_transformVersion = 0;
+    m_nameVersion = 0;
+    m_meshVersion = 0;
+}
+
+void Renderer::ExtractChunkMeshes(minecraft::VoxelWorld* voxelWorld, RenderPacket& packet)
+{
+    packet.hasVoxelWorld = (voxelWorld != nullptr);
+    packet.voxelRevision = (voxelWorld != nullptr) ? voxelWorld->Revision() : 0U;
+    packet.resetChunkMeshes = false;
+    packet.chunkMeshes.clear();
+
+    if ((voxelWorld == nullptr) || !m_backend->WantsChunkMeshes())
+    {
+        return;
+    }
+
+    // A new tracker reports every loaded chunk, so the backend starts over. A world
+    // that was destroyed has already been released by its owner, so whatever is
+    // still tracked here is alive and can drop its tracker.
+    if (voxelWorld != m_trackedWorld)
+    {
+        ReleaseVoxelWorld();
+        m_trackedWorld = voxelWorld;
+        m_dirtyTracker = voxelWorld->RegisterDirtyTracker();
+        m_meshedChunks.clear();
+        packet.resetChunkMeshes = true;
+    }
+
+    voxelWorld->DrainDirtyChunks(m_dirtyTracker, m_dirtyChunks);
+    if (m_dirtyChunks.empty())
+    {
+        return;
+    }
+
+    // Dirty chunks that are still loaded are remeshed; the others left the world
+    // and are sent as empty meshes.
+    RG_PROFILE_SCOPE("Renderer::ExtractChunkMeshes");
+    m_changedChunks.clear();
+    std::vector<minecraft::VoxelChunkMesh> removed;
+    for (const auto& [chunkX, chunkZ] : m_dirtyChunks)
+    {
+        const std::uint64_t key = (static_cast<std::uint64_t>(static_cast<std::uint32_t>(chunkX)) << 32U) |
+            static_cast<std::uint32_t>(chunkZ);
+        if (voxelWorld->HasChunk(chunkX, chunkZ))
+        {
+            m_meshedChunks.insert(key);
+            m_changedChunks.emplace_back(chunkX, chunkZ);
+        }
+        else if (m_meshedChunks.erase(key) != 0)
+        {
+            minecraft::VoxelChunkMesh& mesh = removed.emplace_back();
+            mesh.chunkX = chunkX;
+            mesh.chunkZ = chunkZ;
+        }
+    }
+
+    packet.chunkMeshes.resize(m_changedChunks.size());
+    for (minecraft::VoxelChunkMesh& mesh : removed)
+    {
+        packet.chunkMeshes.push_back(std::move(mesh));
+    }
+
+    const auto& chunks = m_changedChunks;
+    const minecraft::VoxelWorld& world = *voxelWorld;
+    JobSystem::Shared().ParallelFor(chunks.size(), 4, [&world, &chunks, &packet](const std::size_t begin, const std::size_t end)
+    {
+        for (std::size_t index = begin; index < end; ++index)
+        {
+            packet.chunkMeshes[index] = minecraft::VoxelMesher::BuildChunkMesh(world, chunks[index].first, chunks[index].second);
+        }
+    });
+}
+
+void Renderer::DrawPacket(const RenderPacket& packet, const UiRenderCallback& uiCallback)
+{
+    RG_PROFILE_SCOPE("Renderer::Draw");
+    try
+    {
+        m_backend->Render(packet, uiCallback);
+    }
+    catch (const std::exception& exception)
+    {
+        Log::Write(LogLevel::Error, std::string("Render backend failed: ") + exception.what());
+    }
+}
+
+void Renderer::RenderThreadLoop()
+{
+    Profiler::SetThreadName("Render");
+    while (true)
+    {
+        const RenderPacket* packet = nullptr;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_signal.wait(lock, [this]()
+            {
+                return m_stop || (m_pending != nullptr);
+            });
+            if (m_pending == nullptr)
+            {
+                return;
+            }
+            packet = m_pending;
+            m_pending = nullptr;
+            m_drawing = true;
+        }
+
+        DrawPacket(*packet, {});
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_drawing = false;
+        }
+        m_signal.notify_all();
+    }
+}
+
+void Renderer::StopRenderThread()
+{
+    if (!m_renderThread.joinable())
+    {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_signal.notify_all();
+    m_renderThread.join();
+}
 } // namespace rg
@@ -1,35 +1,142 @@
 #pragma once
 
+#include <condition_variable>
+#include <cstddef>
 #include <cstdint>
 #include <functional>
 #include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
 
 #include "Engine/Rendering/IRenderBackend.h"
 #include "Engine/Rendering/RenderAPI.h"
+#include "Engine/Rendering/RenderPacket.h"
 #include "Engine/Resources/ResourceManager.h"
 #include "Engine/Scene/World.h"
 
 namespace rg
 {
+namespace minecraft
+{
+class VoxelWorld;
+}
+
 struct RendererConfig
 {
     RenderAPI api = RenderAPI::Null;
     bool vsync = true;
+    // Draw packets on a dedicated thread so frame N renders while frame N+1
+    // simulates. Frames with a UI callback are still drawn inline.
+    bool renderThread = true;
 };
 
+// Front end of the render backends. Render() extracts a RenderPacket from the
+// live world on the calling thread, then hands it to the render thread. Packets
+// are double-buffered: the next frame is extracted while the previous one is
+// drawn, and a submit waits only for that previous frame.
+//
+// Render instances are mirrored from the world rather than copied every frame:
+// rows follow the change tracking of the name, transform and mesh pools, and an
+// observer on those pools reports entities that gain or lose them. The world
+// passed to Render() must outlive the renderer.
 class Renderer
 {
 public:
+    Renderer() = default;
+    ~Renderer();
+
+    Renderer(const Renderer&) = delete;
+    Renderer& operator=(const Renderer&) = delete;
+
     bool Initialize(const RendererConfig& config, ResourceManager& resources, const RenderBackendContext& context);
     void Render(
-        const World& world,
-        const minecraft::VoxelWorld* voxelWorld = nullptr,
+        World& world,
+        minecraft::VoxelWorld* voxelWorld = nullptr,
         const UiRenderCallback& uiCallback = {});
 
+    // Blocks until every submitted packet has been drawn.
+    void WaitIdle();
+
+    // Drops the dirty-chunk tracker the renderer holds in the voxel world it last
+    // rendered. Call before that world is destroyed or replaced by another one;
+    // the next Render() with a world rebuilds every chunk mesh.
+    void ReleaseVoxelWorld();
+
     [[nodiscard]] const char* BackendName() const;
 
 private:
+    // Queues the entities whose name, transform or mesh component was added or
+    // removed; Renderer re-reads them on the next extraction.
+    class InstanceObserver final : public ecs::IPoolObserver
+    {
+    public:
+        explicit InstanceObserver(std::vector<ecs::EntityId>& staleInstances) : m_staleInstances(staleInstances)
+        {
+        }
+
+        void OnInsert(const ecs::EntityId id) override
+        {
+            m_staleInstances.push_back(id);
+        }
+
+        void OnErase(const ecs::EntityId id) override
+        {
+            m_staleInstances.push_back(id);
+        }
+
+    private:
+        std::vector<ecs::EntityId>& m_staleInstances;
+    };
+
+    void Extract(World& world, minecraft::VoxelWorld* voxelWorld, RenderPacket& packet);
+    // Applies the world's changes to the mirrored instances, then copies the rows
+    // that changed since this packet was last written.
+    void ExtractInstances(World& world, RenderPacket& packet);
+    void RefreshInstance(const ecs::Registry& registry, ecs::EntityId id);
+    void RemoveInstance(ecs::EntityId id);
+    void ReleaseWorld();
+    // Remeshes the chunks the world reports dirty to this renderer's tracker.
+    void ExtractChunkMeshes(minecraft::VoxelWorld* voxelWorld, RenderPacket& packet);
+    void DrawPacket(const RenderPacket& packet, const UiRenderCallback& uiCallback);
+    void RenderThreadLoop();
+    void StopRenderThread();
+
     std::uint64_t m_frameIndex = 0;
     std::unique_ptr<IRenderBackend> m_backend;
+
+    RenderPacket m_packets[2];
+    std::size_t m_writeIndex = 0;
+    // World the dirty tracker belongs to; the backend holds meshes for its chunks.
+    minecraft::VoxelWorld* m_trackedWorld = nullptr;
+    std::size_t m_dirtyTracker = 0;
+    // Chunks the backend holds meshes for, by packed coordinates.
+    std::unordered_set<std::uint64_t> m_meshedChunks;
+    std::vector<std::pair<int, int>> m_dirtyChunks;
+    std::vector<std::pair<int, int>> m_changedChunks;
+
+    World* m_instanceWorld = nullptr;
+    std::vector<RenderInstance> m_instances;
+    std::unordered_map<ecs::EntityId, std::size_t> m_instanceRows;
+    std::vector<ecs::EntityId> m_staleInstances;
+    InstanceObserver m_instanceObserver {m_staleInstances};
+    std::uint64_t m_transformVersion = 0;
+    std::uint64_t m_nameVersion = 0;
+    std::uint64_t m_meshVersion = 0;
+    // Rows written this frame and the previous one; a packet is two frames old
+    // when it is extracted into again.
+    std::vector<std::size_t> m_dirtyRows;
+    std::vector<std::size_t> m_previousDirtyRows;
+    bool m_packetNeedsFullSync[2] = {true, true};
+
+    std::thread m_renderThread;
+    std::mutex m_mutex;
+    std::condition_variable m_signal;
+    const RenderPacket* m_pending = nullptr;
+    bool m_drawing = false;
+    bool m_stop = false;
 };
 } // namespace rg
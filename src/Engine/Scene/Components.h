@@ -37,11 +37,20 @@ struct RigidbodyComponent
     Vector3 velocity {};
     float mass = 1.0f;
     bool useGravity = true;
-    bool isKinematic = false;
+};
+
+// Tag: the body is moved by gameplay code and skipped by physics integration.
+struct KinematicTag
+{
 };
 
 struct VoxelPlayerComponent
 {
+    // The player has no mouse look yet: the camera, block targeting and chunk
+    // streaming all use this eye offset and view direction.
+    static constexpr float kEyeHeight = 1.7f;
+    static constexpr Vector3 kViewDirection {0.0f, -0.2f, 1.0f};
+
     float walkSpeed = 6.0f;
     float jumpSpeed = 7.5f;
     float verticalVelocity = 0.0f;
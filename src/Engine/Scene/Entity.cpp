@@ -28,7 +28,9 @@ const std::string& Entity::GetName() const
 
 void Entity::SetName(std::string name)
 {
-    Registry().GetComponent<NameComponent>(m_id).value = std::move(name);
+    auto& registry = Registry();
+    registry.GetComponent<NameComponent>(m_id).value = std::move(name);
+    registry.MarkChanged<NameComponent>(m_id);
 }
 
 TransformComponent& Entity::Transform()
@@ -41,6 +43,17 @@ const TransformComponent& Entity::Transform() const
     return Registry().GetComponent<TransformComponent>(m_id);
 }
 
+TransformComponent& Entity::MutableTransform()
+{
+    MarkTransformChanged();
+    return Transform();
+}
+
+void Entity::MarkTransformChanged()
+{
+    Registry().MarkChanged<TransformComponent>(m_id);
+}
+
 void Entity::AttachScript(std::string className)
 {
     Registry().AddComponent<ScriptComponent>(m_id, ScriptComponent {std::move(className), true});
@@ -61,6 +74,17 @@ const ScriptComponent& Entity::Script() const
     return Registry().GetComponent<ScriptComponent>(m_id);
 }
 
+ScriptComponent& Entity::MutableScript()
+{
+    MarkScriptChanged();
+    return Script();
+}
+
+void Entity::MarkScriptChanged()
+{
+    Registry().MarkChanged<ScriptComponent>(m_id);
+}
+
 void Entity::AttachMesh(std::string meshAsset, std::string materialAsset)
 {
     Registry().AddComponent<MeshComponent>(m_id, MeshComponent {std::move(meshAsset), std::move(materialAsset), true});
@@ -81,6 +105,17 @@ const MeshComponent& Entity::Mesh() const
     return Registry().GetComponent<MeshComponent>(m_id);
 }
 
+MeshComponent& Entity::MutableMesh()
+{
+    MarkMeshChanged();
+    return Mesh();
+}
+
+void Entity::MarkMeshChanged()
+{
+    Registry().MarkChanged<MeshComponent>(m_id);
+}
+
 ecs::Registry& Entity::Registry()
 {
     if (m_world == nullptr)
@@ -25,18 +25,29 @@ public:
     [[nodiscard]] const std::string& GetName() const;
     void SetName(std::string name);
 
+    // Transform() does not track changes; writers either go through
+    // MutableTransform() or call MarkTransformChanged() once they are done, so
+    // ForEachChanged consumers see the update.
     [[nodiscard]] TransformComponent& Transform();
     [[nodiscard]] const TransformComponent& Transform() const;
+    [[nodiscard]] TransformComponent& MutableTransform();
+    void MarkTransformChanged();
 
     void AttachScript(std::string className);
     [[nodiscard]] bool HasScript() const;
+    // Change tracking works like Transform().
     [[nodiscard]] ScriptComponent& Script();
     [[nodiscard]] const ScriptComponent& Script() const;
+    [[nodiscard]] ScriptComponent& MutableScript();
+    void MarkScriptChanged();
 
     void AttachMesh(std::string meshAsset, std::string materialAsset = {});
     [[nodiscard]] bool HasMesh() const;
+    // Change tracking works like Transform().
     [[nodiscard]] MeshComponent& Mesh();
     [[nodiscard]] const MeshComponent& Mesh() const;
+    [[nodiscard]] MeshComponent& MutableMesh();
+    void MarkMeshChanged();
 
     template <typename Component, typename... Args>
     Component& AddComponent(Args&&... args)
@@ -44,6 +55,12 @@ public:
         return Registry().AddComponent<Component>(m_id, std::forward<Args>(args)...);
     }
 
+    template <typename Component>
+    void RemoveComponent()
+    {
+        Registry().RemoveComponent<Component>(m_id);
+    }
+
     template <typename Component>
     [[nodiscard]] bool HasComponent() const
     {
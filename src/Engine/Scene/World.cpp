@@ -18,6 +18,32 @@ void World::DestroyEntity(const Entity entity)
     }
 }
 
+ecs::PendingEntity World::CreateEntityDeferred(const std::string& name)
+{
+    const auto pending = m_commands.CreateEntity();
+    m_commands.AddComponent<NameComponent>(pending, NameComponent {name});
+    m_commands.AddComponent<TransformComponent>(pending, TransformComponent {});
+    return pending;
+}
+
+void World::DestroyEntityDeferred(const Entity entity)
+{
+    m_commands.DestroyEntity(entity.GetId());
+}
+
+ecs::CommandBuffer& World::Commands()
+{
+    return m_commands;
+}
+
+void World::FlushCommands()
+{
+    if (!m_commands.Empty())
+    {
+        m_commands.Playback(m_registry);
+    }
+}
+
 std::vector<Entity> World::Entities()
 {
     std::vector<Entity> handles;
@@ -31,15 +57,25 @@ std::vector<Entity> World::Entities()
 
 std::vector<Entity> World::Entities() const
 {
-    std::vector<Entity> handles;
+    return const_cast<World*>(this)->Entities();
+}
+
+std::pmr::vector<Entity> World::Entities(std::pmr::memory_resource* resource)
+{
+    std::pmr::vector<Entity> handles(resource);
     handles.reserve(m_registry.EntityCount());
     for (const auto id : m_registry.Entities())
     {
-        handles.emplace_back(const_cast<World*>(this), id);
+        handles.emplace_back(this, id);
     }
     return handles;
 }
 
+std::pmr::vector<Entity> World::Entities(std::pmr::memory_resource* resource) const
+{
+    return const_cast<World*>(this)->Entities(resource);
+}
+
 Entity World::FindEntity(const Entity::Id id)
 {
     return m_registry.IsAlive(id) ? Entity(this, id) : Entity {};
@@ -1,8 +1,13 @@
 #pragma once
 
+#include <cstddef>
 #include <functional>
+#include <memory_resource>
+#include <string>
+#include <utility>
 #include <vector>
 
+#include "Engine/ECS/CommandBuffer.h"
 #include "Engine/ECS/Registry.h"
 #include "Engine/Scene/Entity.h"
 
@@ -14,8 +19,38 @@ public:
     Entity CreateEntity(const std::string& name);
     void DestroyEntity(Entity entity);
 
+    // Batch creation for crowds, particles and level loads: every entity gets the
+    // same name, a copy of transform and a copy of each extra component.
+    template <typename... Components>
+    std::vector<Entity> CreateEntities(
+        const std::size_t count,
+        const std::string& name,
+        const TransformComponent& transform = {},
+        const Components&... extra)
+    {
+        const auto ids = m_registry.CreateEntities(count, NameComponent {name}, transform, extra...);
+        std::vector<Entity> entities;
+        entities.reserve(ids.size());
+        for (const ecs::EntityId id : ids)
+        {
+            entities.emplace_back(this, id);
+        }
+        return entities;
+    }
+
+    // Deferred counterparts for use inside iteration or from worker threads; they
+    // take effect at the next FlushCommands().
+    ecs::PendingEntity CreateEntityDeferred(const std::string& name);
+    void DestroyEntityDeferred(Entity entity);
+    [[nodiscard]] ecs::CommandBuffer& Commands();
+    void FlushCommands();
+
     [[nodiscard]] std::vector<Entity> Entities();
     [[nodiscard]] std::vector<Entity> Entities() const;
+    // Same, allocated from resource. Per-frame callers such as the editor panels
+    // pass FrameAllocator::Shared().Resource() and drop the vector within the frame.
+    [[nodiscard]] std::pmr::vector<Entity> Entities(std::pmr::memory_resource* resource);
+    [[nodiscard]] std::pmr::vector<Entity> Entities(std::pmr::memory_resource* resource) const;
 
     [[nodiscard]] Entity FindEntity(Entity::Id id);
     [[nodiscard]] Entity FindEntity(Entity::Id id) const;
@@ -25,25 +60,47 @@ public:
     [[nodiscard]] ecs::Registry& GetRegistry();
     [[nodiscard]] const ecs::Registry& GetRegistry() const;
 
-    template <typename... Components, typename Func>
+    // Terms are the same as for ecs::Registry::ForEach (components, With, Without,
+    // Optional); the callback receives an Entity instead of the raw id.
+    template <typename... Terms, typename Func>
     void ForEach(Func&& func)
     {
-        m_registry.ForEach<Components...>([this, &func](const ecs::EntityId id, Components&... components)
+        m_registry.ForEach<Terms...>([this, &func](const ecs::EntityId id, auto&&... components)
         {
-            func(Entity(this, id), components...);
+            func(Entity(this, id), std::forward<decltype(components)>(components)...);
         });
     }
 
-    template <typename... Components, typename Func>
+    template <typename... Terms, typename Func>
     void ForEach(Func&& func) const
     {
-        m_registry.ForEach<Components...>([this, &func](const ecs::EntityId id, const Components&... components)
+        m_registry.ForEach<Terms...>([this, &func](const ecs::EntityId id, auto&&... components)
         {
-            func(Entity(const_cast<World*>(this), id), components...);
+            func(Entity(const_cast<World*>(this), id), std::forward<decltype(components)>(components)...);
         });
     }
 
+    // See ecs::Registry::ParallelForEach for what the callback may do.
+    template <typename... Terms, typename Func>
+    void ParallelForEach(Func&& func, const std::size_t minBatch = ecs::Registry::kDefaultParallelBatch)
+    {
+        m_registry.ParallelForEach<Terms...>([this, &func](const ecs::EntityId id, auto&&... components)
+        {
+            func(Entity(this, id), std::forward<decltype(components)>(components)...);
+        }, minBatch);
+    }
+
+    template <typename... Terms, typename Func>
+    void ParallelForEach(Func&& func, const std::size_t minBatch = ecs::Registry::kDefaultParallelBatch) const
+    {
+        m_registry.ParallelForEach<Terms...>([this, &func](const ecs::EntityId id, auto&&... components)
+        {
+            func(Entity(const_cast<World*>(this), id), std::forward<decltype(components)>(components)...);
+        }, minBatch);
+    }
+
 private:
     ecs::Registry m_registry;
+    ecs::CommandBuffer m_commands;
 };
 } // namespace rg
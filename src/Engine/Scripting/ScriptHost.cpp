@@ -9,6 +9,7 @@
 #include <vector>
 
 #include "Engine/Core/Log.h"
+#include "Engine/Core/Profiler.h"
 
 namespace rg
 {
@@ -57,6 +58,7 @@ bool ScriptHost::Initialize()
 
 void ScriptHost::Tick(World& world, const float deltaSeconds)
 {
+    RG_PROFILE_SCOPE("ScriptHost::Tick");
     if (!m_enabled)
     {
         return;
@@ -120,11 +122,20 @@ bool ScriptHost::ResolveRuntimePath()
     return false;
 }
 
-void ScriptHost::WriteInput(const World& world, const float deltaSeconds) const
+void ScriptHost::WriteInput(World& world, const float deltaSeconds)
 {
+    auto& registry = world.GetRegistry();
+    const auto invalidate = [this](const ecs::EntityId id, const auto& /*component*/)
+    {
+        m_inputLines.erase(id);
+    };
+    m_transformVersion = registry.ForEachChanged<TransformComponent>(m_transformVersion, invalidate);
+    m_scriptVersion = registry.ForEachChanged<ScriptComponent>(m_scriptVersion, invalidate);
+
     std::ofstream file(m_inputPath, std::ios::trunc);
     file << std::fixed << std::setprecision(6) << deltaSeconds << '\n';
 
+    std::size_t written = 0;
     world.ForEach<ScriptComponent, TransformComponent>([&](Entity entity, const ScriptComponent& script, const TransformComponent& transform)
     {
         if (!script.enabled)
@@ -132,13 +143,31 @@ void ScriptHost::WriteInput(const World& world, const float deltaSeconds) const
             return;
         }
 
-        file << entity.GetId() << '|'
-             << script.className << '|'
-             << std::fixed << std::setprecision(6)
-             << transform.position.x << '|'
-             << transform.position.y << '|'
-             << transform.position.z << '\n';
+        auto [it, inserted] = m_inputLines.try_emplace(entity.GetId());
+        if (inserted)
+        {
+            std::ostringstream line;
+            line << entity.GetId() << '|'
+                 << script.className << '|'
+                 << std::fixed << std::setprecision(6)
+                 << transform.position.x << '|'
+                 << transform.position.y << '|'
+                 << transform.position.z << '\n';
+            it->second = line.str();
+        }
+
+        file << it->second;
+        ++written;
     });
+
+    // Drop lines of destroyed or unscripted entities once they dominate the cache.
+    if (m_inputLines.size() > (written * 2) + 64)
+    {
+        std::erase_if(m_inputLines, [&registry](const auto& entry)
+        {
+            return !registry.IsAlive(entry.first) || !registry.HasComponent<ScriptComponent>(entry.first);
+        });
+    }
 }
 
 void ScriptHost::ReadOutput(World& world) const
@@ -174,7 +203,7 @@ void ScriptHost::ReadOutput(World& world) const
             Entity entity = world.FindEntity(id);
             if (entity.IsValid())
             {
-                entity.Transform().position = Vector3 {x, y, z};
+                entity.MutableTransform().position = Vector3 {x, y, z};
             }
         }
         catch (...)
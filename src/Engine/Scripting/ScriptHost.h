@@ -1,6 +1,9 @@
 #pragma once
 
+#include <cstdint>
 #include <filesystem>
+#include <string>
+#include <unordered_map>
 
 #include "Engine/Scene/World.h"
 
@@ -16,7 +19,7 @@ public:
 
 private:
     bool ResolveRuntimePath();
-    void WriteInput(const World& world, float deltaSeconds) const;
+    void WriteInput(World& world, float deltaSeconds);
     void ReadOutput(World& world) const;
     bool RunRuntime() const;
 
@@ -24,5 +27,11 @@ private:
     std::filesystem::path m_runtimeDllPath;
     std::filesystem::path m_inputPath;
     std::filesystem::path m_outputPath;
+
+    // Formatted input lines per entity, rebuilt only for entities whose transform
+    // or script changed since the previous tick.
+    std::unordered_map<Entity::Id, std::string> m_inputLines;
+    std::uint64_t m_transformVersion = 0;
+    std::uint64_t m_scriptVersion = 0;
 };
 } // namespace rg
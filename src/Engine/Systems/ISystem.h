@@ -1,9 +1,18 @@
 #pragma once
 
+#include "Engine/Systems/SystemAccess.h"
 #include "Engine/Systems/SystemContext.h"
 
 namespace rg
 {
+// Simulation systems run once per fixed timestep (zero or more times a frame);
+// presentation systems run once per rendered frame.
+enum class SystemPhase
+{
+    Simulation,
+    Presentation
+};
+
 class ISystem
 {
 public:
@@ -12,5 +21,17 @@ public:
     [[nodiscard]] virtual const char* Name() const = 0;
     virtual bool Initialize(SystemContext& context) = 0;
     virtual void Update(SystemContext& context, float deltaSeconds) = 0;
+
+    // Components and engine resources Update() touches; the scheduler uses them to
+    // run non-conflicting systems concurrently. The default is exclusive access.
+    virtual void DeclareAccess(SystemAccess& access) const
+    {
+        access.Exclusive();
+    }
+
+    [[nodiscard]] virtual SystemPhase Phase() const
+    {
+        return SystemPhase::Simulation;
+    }
 };
 } // namespace rg
@@ -12,26 +12,32 @@ const char* PhysicsSystem::Name() const
 
 bool PhysicsSystem::Initialize(SystemContext& context)
 {
-    (void)context;
+    // Rigidbody + Transform is the hottest pair in the frame; the owning group keeps
+    // both pools packed in lockstep so the update below is a straight array walk.
+    context.world.GetRegistry().Group<RigidbodyComponent, TransformComponent>();
     Log::Write(LogLevel::Info, "Initialized PhysicsSystem.");
     return true;
 }
 
+void PhysicsSystem::DeclareAccess(SystemAccess& access) const
+{
+    access.Write<RigidbodyComponent>().Write<TransformComponent>().Read<KinematicTag>();
+}
+
 void PhysicsSystem::Update(SystemContext& context, const float deltaSeconds)
 {
-    context.world.ForEach<RigidbodyComponent, TransformComponent>(
-        [&](Entity /*entity*/, RigidbodyComponent& body, TransformComponent& transform)
+    // Bodies are independent, so batches run on the job system. Kinematic bodies
+    // are filtered out by their tag bit before the callback runs.
+    auto& registry = context.world.GetRegistry();
+    registry.ParallelForEach<RigidbodyComponent, TransformComponent, ecs::Without<KinematicTag>>(
+        [&registry, gravity = m_gravity, deltaSeconds](const ecs::EntityId entity, RigidbodyComponent& body, TransformComponent& transform)
         {
-            if (body.isKinematic)
-            {
-                return;
-            }
-
             if (body.useGravity)
             {
-                body.velocity.y += m_gravity * deltaSeconds;
+                body.velocity.y += gravity * deltaSeconds;
             }
 
+            const Vector3 previous = transform.position;
             transform.position.x += body.velocity.x * deltaSeconds;
             transform.position.y += body.velocity.y * deltaSeconds;
             transform.position.z += body.velocity.z * deltaSeconds;
@@ -45,6 +51,13 @@ void PhysicsSystem::Update(SystemContext& context, const float deltaSeconds)
                     body.velocity.y = 0.0f;
                 }
             }
+
+            // Bodies resting on the ground plane do not count as changed.
+            if ((transform.position.x != previous.x) || (transform.position.y != previous.y) ||
+                (transform.position.z != previous.z))
+            {
+                registry.MarkChanged<TransformComponent>(entity);
+            }
         });
 }
 } // namespace rg
@@ -1,8 +1,10 @@
 #include "Engine/Systems/RenderSystem.h"
 
 #include <string>
+#include <utility>
 
 #include "Editor/EditorUI.h"
+#include "Engine/Core/FrameAllocator.h"
 #include "Engine/Core/Log.h"
 
 namespace rg
@@ -18,15 +20,35 @@ bool RenderSystem::Initialize(SystemContext& context)
     return true;
 }
 
+void RenderSystem::DeclareAccess(SystemAccess& access) const
+{
+    // The graphics API and window belong to the main thread, and the editor UI
+    // drawn here may edit any part of the world.
+    access.MainThread().Exclusive();
+}
+
+SystemPhase RenderSystem::Phase() const
+{
+    return SystemPhase::Presentation;
+}
+
 void RenderSystem::Update(SystemContext& context, const float deltaSeconds)
 {
     if ((context.editorUI != nullptr) && context.editorUI->IsEnabled())
     {
-        context.editorUI->SetFrameStats(
-            editor::EditorFrameStats {
-                deltaSeconds,
-                context.frameIndex,
-                context.renderer.BackendName()});
+        editor::EditorFrameStats stats;
+        stats.deltaSeconds = deltaSeconds;
+        stats.frameIndex = context.frameIndex;
+        stats.rendererBackend = context.renderer.BackendName();
+        stats.frameMemoryUsed = FrameAllocator::Shared().BytesUsed();
+        stats.frameMemoryCapacity = FrameAllocator::Shared().Capacity();
+        if (context.lastFrameStats != nullptr)
+        {
+            stats.systemsMs = static_cast<float>(context.lastFrameStats->wallMs);
+            stats.criticalPathMs = static_cast<float>(context.lastFrameStats->criticalPathMs);
+            stats.criticalPath = context.lastFrameStats->CriticalPathString();
+        }
+        context.editorUI->SetFrameStats(std::move(stats));
 
         context.renderer.Render(context.world, context.voxelWorld, [editor = context.editorUI]()
         {
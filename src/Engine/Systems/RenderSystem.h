@@ -10,5 +10,7 @@ public:
     [[nodiscard]] const char* Name() const override;
     bool Initialize(SystemContext& context) override;
     void Update(SystemContext& context, float deltaSeconds) override;
+    void DeclareAccess(SystemAccess& access) const override;
+    [[nodiscard]] SystemPhase Phase() const override;
 };
 } // namespace rg
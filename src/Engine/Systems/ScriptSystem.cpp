@@ -1,6 +1,7 @@
 #include "Engine/Systems/ScriptSystem.h"
 
 #include "Engine/Core/Log.h"
+#include "Engine/Scene/Components.h"
 
 namespace rg
 {
@@ -16,6 +17,12 @@ bool ScriptSystem::Initialize(SystemContext& context)
     return true;
 }
 
+void ScriptSystem::DeclareAccess(SystemAccess& access) const
+{
+    // ScriptHost consumes change checkpoints of both pools, which counts as a write.
+    access.Write<ScriptComponent>().Write<TransformComponent>().Write(EngineResource::ScriptHost);
+}
+
 void ScriptSystem::Update(SystemContext& context, const float deltaSeconds)
 {
     context.scriptHost.Tick(context.world, deltaSeconds);
@@ -10,5 +10,6 @@ public:
     [[nodiscard]] const char* Name() const override;
     bool Initialize(SystemContext& context) override;
     void Update(SystemContext& context, float deltaSeconds) override;
+    void DeclareAccess(SystemAccess& access) const override;
 };
 } // namespace rg
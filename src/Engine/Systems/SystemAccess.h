@@ -0,0 +1,123 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Engine/ECS/ComponentType.h"
+
+namespace rg
+{
+// Engine-owned state a system can touch besides ECS components.
+enum class EngineResource : std::uint8_t
+{
+    Input,
+    Window,
+    Renderer,
+    Resources,
+    ScriptHost,
+    EditorUI,
+    VoxelWorld
+};
+
+// What a system reads and writes during Update(). The scheduler runs two systems
+// concurrently only when their declarations do not conflict, i.e. neither writes
+// a component type or resource the other one reads or writes.
+//
+// Structural ECS changes (creating/destroying entities, adding/removing
+// components) are not covered by component access: record them in the world
+// command buffer, or declare the system Exclusive().
+class SystemAccess
+{
+public:
+    template <typename Component>
+    SystemAccess& Read()
+    {
+        m_readComponents.push_back(ecs::ComponentTypeId<Component>());
+        return *this;
+    }
+
+    template <typename Component>
+    SystemAccess& Write()
+    {
+        m_writeComponents.push_back(ecs::ComponentTypeId<Component>());
+        return *this;
+    }
+
+    SystemAccess& Read(const EngineResource resource)
+    {
+        m_readResources |= Bit(resource);
+        return *this;
+    }
+
+    SystemAccess& Write(const EngineResource resource)
+    {
+        m_writeResources |= Bit(resource);
+        return *this;
+    }
+
+    // Conflicts with every other system, e.g. for code that may touch arbitrary
+    // world state such as editor UI.
+    SystemAccess& Exclusive()
+    {
+        m_exclusive = true;
+        return *this;
+    }
+
+    // Must run on the thread that drives the engine loop (window, graphics API).
+    SystemAccess& MainThread()
+    {
+        m_mainThread = true;
+        return *this;
+    }
+
+    [[nodiscard]] bool IsExclusive() const
+    {
+        return m_exclusive;
+    }
+
+    [[nodiscard]] bool IsMainThread() const
+    {
+        return m_mainThread;
+    }
+
+    [[nodiscard]] bool ConflictsWith(const SystemAccess& other) const
+    {
+        if (m_exclusive || other.m_exclusive)
+        {
+            return true;
+        }
+
+        if (((m_writeResources & (other.m_readResources | other.m_writeResources)) != 0) ||
+            ((other.m_writeResources & m_readResources) != 0))
+        {
+            return true;
+        }
+
+        return WritesAnyOf(other.m_readComponents) || WritesAnyOf(other.m_writeComponents) ||
+               other.WritesAnyOf(m_readComponents);
+    }
+
+private:
+    [[nodiscard]] static std::uint32_t Bit(const EngineResource resource)
+    {
+        return 1U << static_cast<std::uint32_t>(resource);
+    }
+
+    [[nodiscard]] bool WritesAnyOf(const std::vector<std::size_t>& types) const
+    {
+        return std::any_of(types.begin(), types.end(), [this](const std::size_t type)
+        {
+            return std::find(m_writeComponents.begin(), m_writeComponents.end(), type) != m_writeComponents.end();
+        });
+    }
+
+    std::vector<std::size_t> m_readComponents;
+    std::vector<std::size_t> m_writeComponents;
+    std::uint32_t m_readResources = 0;
+    std::uint32_t m_writeResources = 0;
+    bool m_exclusive = false;
+    bool m_mainThread = false;
+};
+} // namespace rg
@@ -8,6 +8,7 @@
 #include "Engine/Resources/ResourceManager.h"
 #include "Engine/Scene/World.h"
 #include "Engine/Scripting/ScriptHost.h"
+#include "Engine/Systems/SystemStats.h"
 
 namespace rg
 {
@@ -32,5 +33,7 @@ struct SystemContext
     editor::EditorUI* editorUI = nullptr;
     minecraft::VoxelWorld* voxelWorld = nullptr;
     std::uint64_t frameIndex = 0;
+    // Scheduler timings of the previous frame, if any.
+    const SystemFrameStats* lastFrameStats = nullptr;
 };
 } // namespace rg
@@ -0,0 +1,237 @@
+#include "Engine/Systems/SystemScheduler.h"
+
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <memory_resource>
+#include <mutex>
+#include <thread>
+
+#include "Engine/Core/FrameAllocator.h"
+#include "Engine/Core/JobSystem.h"
+#include "Engine/Core/Profiler.h"
+
+namespace rg
+{
+namespace
+{
+using Clock = std::chrono::steady_clock;
+
+double MillisecondsBetween(const Clock::time_point begin, const Clock::time_point end)
+{
+    return std::chrono::duration<double, std::milli>(end - begin).count();
+}
+} // namespace
+
+struct SystemScheduler::FrameState
+{
+    FrameState(SystemContext& frameContext, const float frameDeltaSeconds, const std::size_t systemCount)
+        : context(frameContext),
+          deltaSeconds(frameDeltaSeconds),
+          start(Clock::now()),
+          remainingPredecessors(systemCount, FrameAllocator::Shared().Resource()),
+          mainThreadReady(FrameAllocator::Shared().Resource())
+    {
+        mainThreadReady.reserve(systemCount);
+    }
+
+    SystemContext& context;
+    float deltaSeconds = 0.0f;
+    Clock::time_point start;
+    std::pmr::vector<std::atomic<std::size_t>> remainingPredecessors;
+    std::atomic<std::size_t> finished {0};
+    JobCounter jobs;
+
+    std::mutex mainThreadMutex;
+    std::pmr::vector<std::size_t> mainThreadReady;
+
+    std::mutex errorMutex;
+    std::exception_ptr error;
+};
+
+void SystemScheduler::Build(const std::vector<std::unique_ptr<ISystem>>& systems, const SystemPhase phase)
+{
+    m_nodes.clear();
+    m_nodes.reserve(systems.size());
+    for (const auto& system : systems)
+    {
+        if (system->Phase() != phase)
+        {
+            continue;
+        }
+
+        Node node;
+        node.system = system.get();
+        system->DeclareAccess(node.access);
+        m_nodes.push_back(std::move(node));
+    }
+
+    // Conflicting systems keep their registration order; everything else is free.
+    for (std::size_t later = 0; later < m_nodes.size(); ++later)
+    {
+        for (std::size_t earlier = 0; earlier < later; ++earlier)
+        {
+            if (m_nodes[earlier].access.ConflictsWith(m_nodes[later].access))
+            {
+                m_nodes[earlier].successors.push_back(later);
+                m_nodes[later].predecessors.push_back(earlier);
+            }
+        }
+    }
+
+    m_stats = SystemFrameStats {};
+    m_stats.systems.resize(m_nodes.size());
+    for (std::size_t index = 0; index < m_nodes.size(); ++index)
+    {
+        m_stats.systems[index].name = m_nodes[index].system->Name();
+    }
+}
+
+void SystemScheduler::Run(SystemContext& context, const float deltaSeconds)
+{
+    const std::size_t count = m_nodes.size();
+    FrameState frame(context, deltaSeconds, count);
+    for (std::size_t index = 0; index < count; ++index)
+    {
+        frame.remainingPredecessors[index].store(m_nodes[index].predecessors.size());
+    }
+
+    for (std::size_t index = 0; index < count; ++index)
+    {
+        if (m_nodes[index].predecessors.empty())
+        {
+            Dispatch(frame, index);
+        }
+    }
+
+    // The calling thread runs main-thread systems as they become ready and helps
+    // with this frame's system jobs otherwise. Other queued work (streaming, a
+    // system's own ParallelFor chunks) is left to the workers so a long job does
+    // not hold up the main-thread systems.
+    JobSystem& jobs = JobSystem::Shared();
+    while (frame.finished.load() < count)
+    {
+        std::size_t next = count;
+        {
+            std::lock_guard<std::mutex> lock(frame.mainThreadMutex);
+            if (!frame.mainThreadReady.empty())
+            {
+                next = frame.mainThreadReady.back();
+                frame.mainThreadReady.pop_back();
+            }
+        }
+
+        if (next != count)
+        {
+            Execute(frame, next);
+        }
+        else if (!jobs.RunPendingJob(frame.jobs))
+        {
+            std::this_thread::yield();
+        }
+    }
+    jobs.Wait(frame.jobs);
+
+    m_stats.frameIndex = context.frameIndex;
+    m_stats.wallMs = MillisecondsBetween(frame.start, Clock::now());
+    ComputeCriticalPath();
+
+    if (frame.error != nullptr)
+    {
+        std::rethrow_exception(frame.error);
+    }
+}
+
+const SystemFrameStats& SystemScheduler::LastFrame() const
+{
+    return m_stats;
+}
+
+void SystemScheduler::Dispatch(FrameState& frame, const std::size_t index)
+{
+    if (m_nodes[index].access.IsMainThread())
+    {
+        std::lock_guard<std::mutex> lock(frame.mainThreadMutex);
+        frame.mainThreadReady.push_back(index);
+        return;
+    }
+
+    JobSystem::Shared().Spawn(frame.jobs, [this, &frame, index]()
+    {
+        Execute(frame, index);
+    });
+}
+
+void SystemScheduler::Execute(FrameState& frame, const std::size_t index)
+{
+    const Node& node = m_nodes[index];
+    const Clock::time_point begin = Clock::now();
+    try
+    {
+        RG_PROFILE_SCOPE(node.system->Name());
+        node.system->Update(frame.context, frame.deltaSeconds);
+    }
+    catch (...)
+    {
+        std::lock_guard<std::mutex> lock(frame.errorMutex);
+        if (frame.error == nullptr)
+        {
+            frame.error = std::current_exception();
+        }
+    }
+    const Clock::time_point end = Clock::now();
+
+    // Each system writes only its own slot.
+    SystemTiming& timing = m_stats.systems[index];
+    timing.startMs = MillisecondsBetween(frame.start, begin);
+    timing.durationMs = MillisecondsBetween(begin, end);
+
+    for (const std::size_t successor : node.successors)
+    {
+        if (frame.remainingPredecessors[successor].fetch_sub(1) == 1)
+        {
+            Dispatch(frame, successor);
+        }
+    }
+    frame.finished.fetch_add(1);
+}
+
+void SystemScheduler::ComputeCriticalPath()
+{
+    // Edges always point from a lower to a higher index, so index order is a
+    // topological order.
+    const std::size_t count = m_nodes.size();
+    std::pmr::vector<double> finish(count, 0.0, FrameAllocator::Shared().Resource());
+    std::pmr::vector<std::size_t> via(count, count, FrameAllocator::Shared().Resource());
+    std::size_t last = count;
+    m_stats.totalMs = 0.0;
+    for (std::size_t index = 0; index < count; ++index)
+    {
+        double ready = 0.0;
+        for (const std::size_t predecessor : m_nodes[index].predecessors)
+        {
+            if (finish[predecessor] > ready)
+            {
+                ready = finish[predecessor];
+                via[index] = predecessor;
+            }
+        }
+
+        finish[index] = ready + m_stats.systems[index].durationMs;
+        m_stats.totalMs += m_stats.systems[index].durationMs;
+        m_stats.systems[index].onCriticalPath = false;
+        if ((last == count) || (finish[index] > finish[last]))
+        {
+            last = index;
+        }
+    }
+
+    m_stats.criticalPath.clear();
+    m_stats.criticalPathMs = (last != count) ? finish[last] : 0.0;
+    for (std::size_t index = last; index != count; index = via[index])
+    {
+        m_stats.criticalPath.insert(m_stats.criticalPath.begin(), index);
+        m_stats.systems[index].onCriticalPath = true;
+    }
+}
+} // namespace rg
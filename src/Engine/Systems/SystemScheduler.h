@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include "Engine/Systems/ISystem.h"
+#include "Engine/Systems/SystemAccess.h"
+#include "Engine/Systems/SystemStats.h"
+
+namespace rg
+{
+// Runs the engine systems as a per-frame task graph. Build() collects every
+// system's declared access and orders each conflicting pair by registration
+// order; Run() then starts every system as soon as its predecessors are done, on
+// the job system or, for MainThread() systems, on the calling thread. Systems
+// without conflicts run concurrently. Per-frame timings and the critical path are
+// available through LastFrame().
+class SystemScheduler
+{
+public:
+    // Takes the systems of the given phase, keeping their registration order.
+    void Build(const std::vector<std::unique_ptr<ISystem>>& systems, SystemPhase phase);
+
+    // Runs every system once. If systems throw, the rest of the frame still runs
+    // and the first exception is rethrown afterwards.
+    void Run(SystemContext& context, float deltaSeconds);
+
+    [[nodiscard]] const SystemFrameStats& LastFrame() const;
+
+private:
+    struct Node
+    {
+        ISystem* system = nullptr;
+        SystemAccess access;
+        std::vector<std::size_t> predecessors;
+        std::vector<std::size_t> successors;
+    };
+
+    struct FrameState;
+
+    void Dispatch(FrameState& frame, std::size_t index);
+    void Execute(FrameState& frame, std::size_t index);
+    void ComputeCriticalPath();
+
+    std::vector<Node> m_nodes;
+    SystemFrameStats m_stats;
+};
+} // namespace rg
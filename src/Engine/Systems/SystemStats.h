@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace rg
+{
+struct SystemTiming
+{
+    const char* name = "";
+    // Relative to the start of the frame's system phase.
+    double startMs = 0.0;
+    double durationMs = 0.0;
+    bool onCriticalPath = false;
+};
+
+// Timings of one run of the system scheduler, in registration order.
+struct SystemFrameStats
+{
+    std::uint64_t frameIndex = 0;
+    // Wall time of the whole system phase.
+    double wallMs = 0.0;
+    // Sum of all system durations, i.e. the serial cost.
+    double totalMs = 0.0;
+    // Longest dependency chain by measured duration: the lower bound on wallMs
+    // however many workers are available.
+    double criticalPathMs = 0.0;
+    std::vector<SystemTiming> systems;
+    // Indices into systems, in execution order.
+    std::vector<std::size_t> criticalPath;
+
+    [[nodiscard]] std::string CriticalPathString() const
+    {
+        std::string text;
+        for (const std::size_t index : criticalPath)
+        {
+            if (!text.empty())
+            {
+                text += " -> ";
+            }
+            text += systems[index].name;
+        }
+        return text;
+    }
+};
+} // namespace rg
@@ -62,6 +62,15 @@ bool VoxelGameplaySystem::Initialize(SystemContext& context)
     return true;
 }
 
+void VoxelGameplaySystem::DeclareAccess(SystemAccess& access) const
+{
+    // The player is spawned through the world command buffer, not structurally.
+    access.Write<VoxelPlayerComponent>()
+        .Write<TransformComponent>()
+        .Read(EngineResource::Input)
+        .Write(EngineResource::VoxelWorld);
+}
+
 void VoxelGameplaySystem::Update(SystemContext& context, const float deltaSeconds)
 {
     if (context.voxelWorld == nullptr)
@@ -87,9 +96,12 @@ void VoxelGameplaySystem::EnsurePlayerEntity(SystemContext& context) const
         return;
     }
 
-    Entity player = context.world.CreateEntity("VoxelPlayer");
-    player.Transform().position = Vector3 {0.0f, 30.0f, 0.0f};
-    player.AddComponent<VoxelPlayerComponent>();
+    // Spawned through the world command buffer; the player appears after the
+    // engine flushes commands at the end of the frame.
+    const auto player = context.world.CreateEntityDeferred("VoxelPlayer");
+    auto& commands = context.world.Commands();
+    commands.AddComponent<TransformComponent>(player, TransformComponent {Vector3 {0.0f, 30.0f, 0.0f}});
+    commands.AddComponent<VoxelPlayerComponent>(player);
 }
 
 void VoxelGameplaySystem::UpdateMovement(SystemContext& context, Entity player, const float deltaSeconds) const
@@ -99,6 +111,19 @@ void VoxelGameplaySystem::UpdateMovement(SystemContext& context, Entity player,
     auto& input = context.input;
     auto& world = *context.voxelWorld;
 
+    // The ground under the player may not be loaded yet (streaming); hold still.
+    const auto isLoaded = [&world](const float x, const float z)
+    {
+        return world.HasChunk(
+            minecraft::VoxelWorld::ToChunkCoordinate(static_cast<int>(std::floor(x))),
+            minecraft::VoxelWorld::ToChunkCoordinate(static_cast<int>(std::floor(z))));
+    };
+    if (!isLoaded(transform.position.x, transform.position.z))
+    {
+        return;
+    }
+    const Vector3 previous = transform.position;
+
     float moveX = 0.0f;
     float moveZ = 0.0f;
     if (input.IsDown(KeyCode::W))
@@ -126,17 +151,18 @@ void VoxelGameplaySystem::UpdateMovement(SystemContext& context, Entity player,
         moveZ *= invLength;
     }
 
-    transform.position.x += moveX * controller.walkSpeed * deltaSeconds;
-    transform.position.z += moveZ * controller.walkSpeed * deltaSeconds;
-
-    transform.position.x = std::clamp(
-        transform.position.x,
-        static_cast<float>(world.MinWorldX() + 1),
-        static_cast<float>(world.MaxWorldX() - 1));
-    transform.position.z = std::clamp(
-        transform.position.z,
-        static_cast<float>(world.MinWorldZ() + 1),
-        static_cast<float>(world.MaxWorldZ() - 1));
+    // Each axis moves only onto loaded chunks: the edge of a fixed world, or the
+    // part of a streamed one that has not arrived yet.
+    const float nextX = transform.position.x + (moveX * controller.walkSpeed * deltaSeconds);
+    if (isLoaded(nextX, transform.position.z))
+    {
+        transform.position.x = nextX;
+    }
+    const float nextZ = transform.position.z + (moveZ * controller.walkSpeed * deltaSeconds);
+    if (isLoaded(transform.position.x, nextZ))
+    {
+        transform.position.z = nextZ;
+    }
 
     const int sampleX = static_cast<int>(std::floor(transform.position.x));
     const int sampleZ = static_cast<int>(std::floor(transform.position.z));
@@ -166,11 +192,18 @@ void VoxelGameplaySystem::UpdateMovement(SystemContext& context, Entity player,
     }
 
     transform.position.y = std::clamp(transform.position.y, 1.0f, static_cast<float>(minecraft::VoxelWorld::kWorldHeight - 1));
+
+    // A player standing still does not count as changed.
+    if ((transform.position.x != previous.x) || (transform.position.y != previous.y) ||
+        (transform.position.z != previous.z))
+    {
+        player.MarkTransformChanged();
+    }
 }
 
 void VoxelGameplaySystem::UpdateBlockInteraction(SystemContext& context, Entity player) const
 {
-    auto& transform = player.Transform();
+    const auto& transform = player.Transform();
     auto& controller = player.GetComponent<VoxelPlayerComponent>();
     auto& input = context.input;
     auto& world = *context.voxelWorld;
@@ -180,10 +213,10 @@ void VoxelGameplaySystem::UpdateBlockInteraction(SystemContext& context, Entity
         controller.selectedBlockId = static_cast<std::uint8_t>((controller.selectedBlockId + 1U) % 5U);
     }
 
-    const Vector3 origin {transform.position.x, transform.position.y + 1.5f, transform.position.z};
-    const Vector3 direction {0.0f, -0.3f, 1.0f};
+    // Targets the block the camera looks at.
+    const Vector3 origin {transform.position.x, transform.position.y + VoxelPlayerComponent::kEyeHeight, transform.position.z};
     minecraft::BlockHit hit;
-    if (!world.Raycast(origin, direction, controller.reachDistance, hit))
+    if (!world.Raycast(origin, VoxelPlayerComponent::kViewDirection, controller.reachDistance, hit))
     {
         return;
     }
@@ -10,6 +10,7 @@ public:
     [[nodiscard]] const char* Name() const override;
     bool Initialize(SystemContext& context) override;
     void Update(SystemContext& context, float deltaSeconds) override;
+    void DeclareAccess(SystemAccess& access) const override;
 
 private:
     void EnsurePlayerEntity(SystemContext& context) const;
@@ -0,0 +1,65 @@
+#include "Engine/Systems/VoxelStreamingSystem.h"
+
+#include <string>
+
+#include "Engine/Core/Log.h"
+#include "Engine/Scene/Components.h"
+
+namespace rg
+{
+VoxelStreamingSystem::VoxelStreamingSystem(const minecraft::VoxelStreamingSettings& settings) : m_streamer(settings)
+{
+}
+
+const char* VoxelStreamingSystem::Name() const
+{
+    return "VoxelStreamingSystem";
+}
+
+bool VoxelStreamingSystem::Initialize(SystemContext& context)
+{
+    if (context.voxelWorld == nullptr)
+    {
+        Log::Write(LogLevel::Error, "VoxelStreamingSystem requires VoxelWorld.");
+        return false;
+    }
+
+    Log::Write(
+        LogLevel::Info,
+        "Initialized VoxelStreamingSystem: view distance " + std::to_string(m_streamer.Settings().viewDistanceInChunks) +
+            " chunks, budget " + std::to_string(m_streamer.Settings().memoryBudgetBytes >> 20U) + " MiB.");
+    return true;
+}
+
+void VoxelStreamingSystem::DeclareAccess(SystemAccess& access) const
+{
+    access.Read<VoxelPlayerComponent>().Read<TransformComponent>().Write(EngineResource::VoxelWorld);
+}
+
+SystemPhase VoxelStreamingSystem::Phase() const
+{
+    return SystemPhase::Presentation;
+}
+
+void VoxelStreamingSystem::Update(SystemContext& context, const float /*deltaSeconds*/)
+{
+    if (context.voxelWorld == nullptr)
+    {
+        return;
+    }
+
+    // Before the player exists the ring is centered on the spawn point.
+    Vector3 viewer {};
+    bool found = false;
+    context.world.ForEach<VoxelPlayerComponent, TransformComponent>([&](Entity, const VoxelPlayerComponent&, const TransformComponent& transform)
+    {
+        if (!found)
+        {
+            viewer = transform.position;
+            found = true;
+        }
+    });
+
+    m_streamer.Update(*context.voxelWorld, viewer, VoxelPlayerComponent::kViewDirection);
+}
+} // namespace rg
@@ -0,0 +1,23 @@
+#pragma once
+
+#include "Engine/Systems/ISystem.h"
+#include "Game/Minecraft/VoxelStreamer.h"
+
+namespace rg
+{
+// Streams the voxel world around the voxel player once per rendered frame.
+class VoxelStreamingSystem final : public ISystem
+{
+public:
+    explicit VoxelStreamingSystem(const minecraft::VoxelStreamingSettings& settings);
+
+    [[nodiscard]] const char* Name() const override;
+    bool Initialize(SystemContext& context) override;
+    void Update(SystemContext& context, float deltaSeconds) override;
+    void DeclareAccess(SystemAccess& access) const override;
+    [[nodiscard]] SystemPhase Phase() const override;
+
+private:
+    minecraft::VoxelStreamer m_streamer;
+};
+} // namespace rg
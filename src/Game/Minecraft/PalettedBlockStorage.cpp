@@ -0,0 +1,191 @@
+#include "Game/Minecraft/PalettedBlockStorage.h"
+
+#include <algorithm>
+#include <array>
+#include <stdexcept>
+#include <utility>
+
+namespace rg::minecraft
+{
+namespace
+{
+constexpr unsigned kMaxBitsLog2 = 3;
+
+std::size_t WordCount(const std::size_t size, const unsigned bitsLog2)
+{
+    return ((size << bitsLog2) + 63U) / 64U;
+}
+
+// Narrowest width whose index range holds paletteSize entries.
+unsigned BitsLog2For(const std::size_t paletteSize)
+{
+    unsigned bitsLog2 = 0;
+    while ((bitsLog2 < kMaxBitsLog2) && ((std::size_t {1} << (1U << bitsLog2)) < paletteSize))
+    {
+        ++bitsLog2;
+    }
+    return bitsLog2;
+}
+} // namespace
+
+PalettedBlockStorage::PalettedBlockStorage(const std::size_t size, const std::uint8_t fill)
+    : m_uniform(fill),
+      m_size(size)
+{
+}
+
+void PalettedBlockStorage::Assign(const std::uint8_t* values, const std::size_t size)
+{
+    std::array<bool, 256> present {};
+    for (std::size_t index = 0; index < size; ++index)
+    {
+        present[values[index]] = true;
+    }
+
+    std::array<std::uint8_t, 256> lookup {};
+    m_palette.clear();
+    for (std::size_t value = 0; value < present.size(); ++value)
+    {
+        if (present[value])
+        {
+            lookup[value] = static_cast<std::uint8_t>(m_palette.size());
+            m_palette.push_back(static_cast<std::uint8_t>(value));
+        }
+    }
+
+    m_size = size;
+    if (m_palette.size() <= 1U)
+    {
+        m_uniform = m_palette.empty() ? std::uint8_t {0} : m_palette.front();
+        m_palette = {};
+        m_words = {};
+        return;
+    }
+
+    m_bitsLog2 = BitsLog2For(m_palette.size());
+    m_words.resize(WordCount(size, m_bitsLog2));
+    const unsigned bits = 1U << m_bitsLog2;
+    const std::size_t perWord = std::size_t {64} >> m_bitsLog2;
+    for (std::size_t word = 0; word < m_words.size(); ++word)
+    {
+        const std::size_t begin = word * perWord;
+        const std::size_t end = std::min(begin + perWord, size);
+        std::uint64_t packed = 0;
+        for (std::size_t index = end; index > begin; --index)
+        {
+            packed = (packed << bits) | lookup[values[index - 1U]];
+        }
+        m_words[word] = packed;
+    }
+}
+
+void PalettedBlockStorage::Unpack(std::uint8_t* values) const
+{
+    if (m_words.empty())
+    {
+        std::fill_n(values, m_size, m_uniform);
+        return;
+    }
+
+    const unsigned bits = 1U << m_bitsLog2;
+    const std::size_t perWord = std::size_t {64} >> m_bitsLog2;
+    const std::uint64_t mask = (std::uint64_t {1} << bits) - 1U;
+    for (std::size_t word = 0; word < m_words.size(); ++word)
+    {
+        const std::size_t begin = word * perWord;
+        const std::size_t end = std::min(begin + perWord, m_size);
+        std::uint64_t packed = m_words[word];
+        for (std::size_t index = begin; index < end; ++index)
+        {
+            values[index] = m_palette[static_cast<std::size_t>(packed & mask)];
+            packed >>= bits;
+        }
+    }
+}
+
+void PalettedBlockStorage::Set(const std::size_t index, const std::uint8_t value)
+{
+    if (index >= m_size)
+    {
+        throw std::out_of_range("Block storage index is out of range.");
+    }
+
+    if (m_words.empty())
+    {
+        if (value == m_uniform)
+        {
+            return;
+        }
+
+        // Leaving uniform: a 1-bit array of index 0, then the write below.
+        m_palette = {m_uniform};
+        m_bitsLog2 = 0;
+        m_words.assign(WordCount(m_size, 0), 0U);
+    }
+
+    const auto it = std::find(m_palette.begin(), m_palette.end(), value);
+    std::size_t paletteIndex = static_cast<std::size_t>(it - m_palette.begin());
+    if (it == m_palette.end())
+    {
+        if (m_palette.size() == (std::size_t {1} << (1U << m_bitsLog2)))
+        {
+            Resize(m_bitsLog2 + 1U);
+        }
+        m_palette.push_back(value);
+    }
+    WriteIndex(index, static_cast<std::uint32_t>(paletteIndex));
+}
+
+std::size_t PalettedBlockStorage::Size() const
+{
+    return m_size;
+}
+
+bool PalettedBlockStorage::IsUniform() const
+{
+    return m_words.empty();
+}
+
+std::uint8_t PalettedBlockStorage::UniformValue() const
+{
+    return m_uniform;
+}
+
+unsigned PalettedBlockStorage::BitsPerEntry() const
+{
+    return m_words.empty() ? 0U : (1U << m_bitsLog2);
+}
+
+std::size_t PalettedBlockStorage::PaletteSize() const
+{
+    return m_words.empty() ? 1U : m_palette.size();
+}
+
+std::size_t PalettedBlockStorage::MemoryBytes() const
+{
+    return m_palette.capacity() + (m_words.capacity() * sizeof(std::uint64_t));
+}
+
+void PalettedBlockStorage::Resize(const unsigned bitsLog2)
+{
+    std::vector<std::uint64_t> words(WordCount(m_size, bitsLog2), 0U);
+    const std::uint64_t mask = (std::uint64_t {1} << (1U << m_bitsLog2)) - 1U;
+    for (std::size_t index = 0; index < m_size; ++index)
+    {
+        const std::size_t oldBit = index << m_bitsLog2;
+        const std::uint64_t paletteIndex = (m_words[oldBit >> 6U] >> (oldBit & 63U)) & mask;
+        const std::size_t newBit = index << bitsLog2;
+        words[newBit >> 6U] |= paletteIndex << (newBit & 63U);
+    }
+    m_words = std::move(words);
+    m_bitsLog2 = bitsLog2;
+}
+
+void PalettedBlockStorage::WriteIndex(const std::size_t index, const std::uint32_t paletteIndex)
+{
+    const std::size_t bit = index << m_bitsLog2;
+    const std::uint64_t mask = ((std::uint64_t {1} << (1U << m_bitsLog2)) - 1U) << (bit & 63U);
+    std::uint64_t& word = m_words[bit >> 6U];
+    word = (word & ~mask) | (static_cast<std::uint64_t>(paletteIndex) << (bit & 63U));
+}
+} // namespace rg::minecraft
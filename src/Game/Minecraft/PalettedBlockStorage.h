@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace rg::minecraft
+{
+// Fixed-size array of block ids stored as indices into a small palette of the ids
+// actually present, packed at 1, 2, 4 or 8 bits per entry. A chunk of stone, dirt,
+// grass and air needs 2 bits per block instead of 8. Entries never straddle a
+// 64-bit word, since every width divides 64. Writing an id the palette does not
+// hold adds it, doubling the width when the palette outgrows it; palettes never
+// shrink on their own. An array holding a single id is uniform: it keeps just
+// that id and allocates nothing until a different id is written.
+class PalettedBlockStorage
+{
+public:
+    // Holds no entries; give it a size with Assign() before any Get() or Set().
+    PalettedBlockStorage() = default;
+    // size entries, all equal to fill.
+    PalettedBlockStorage(std::size_t size, std::uint8_t fill);
+
+    // Replaces the content with size values, picking the narrowest width that fits.
+    void Assign(const std::uint8_t* values, std::size_t size);
+    // Writes all Size() values to values; the inverse of Assign.
+    void Unpack(std::uint8_t* values) const;
+
+    // index must be below Size(); Get() is unchecked, Set() throws
+    // std::out_of_range.
+    [[nodiscard]] std::uint8_t Get(const std::size_t index) const
+    {
+        if (m_words.empty())
+        {
+            return m_uniform;
+        }
+
+        const std::size_t bit = index << m_bitsLog2;
+        const std::uint64_t word = m_words[bit >> 6U];
+        const std::uint64_t mask = (std::uint64_t {1} << (1U << m_bitsLog2)) - 1U;
+        return m_palette[static_cast<std::size_t>((word >> (bit & 63U)) & mask)];
+    }
+
+    void Set(std::size_t index, std::uint8_t value);
+
+    [[nodiscard]] std::size_t Size() const;
+    [[nodiscard]] bool IsUniform() const;
+    // The id every entry holds; only meaningful when IsUniform().
+    [[nodiscard]] std::uint8_t UniformValue() const;
+    // 0 when uniform.
+    [[nodiscard]] unsigned BitsPerEntry() const;
+    [[nodiscard]] std::size_t PaletteSize() const;
+    // Heap bytes held by the palette and the packed words.
+    [[nodiscard]] std::size_t MemoryBytes() const;
+
+private:
+    void Resize(unsigned bitsLog2);
+    void WriteIndex(std::size_t index, std::uint32_t paletteIndex);
+
+    // Both empty while uniform.
+    std::vector<std::uint8_t> m_palette;
+    std::vector<std::uint64_t> m_words;
+    std::uint8_t m_uniform = 0;
+    std::size_t m_size = 0;
+    // Bits per entry are 1 << m_bitsLog2.
+    unsigned m_bitsLog2 = 0;
+};
+} // namespace rg::minecraft
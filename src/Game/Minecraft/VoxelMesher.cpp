@@ -2,6 +2,10 @@
 
 #include <algorithm>
 #include <array>
+#include <memory_resource>
+
+#include "Engine/Core/FrameAllocator.h"
+#include "Engine/Core/Profiler.h"
 
 namespace rg::minecraft
 {
@@ -18,6 +22,13 @@ struct MaskCell
     }
 };
 
+enum class SectionFill : std::uint8_t
+{
+    Mixed,
+    Empty,
+    Solid
+};
+
 [[nodiscard]] bool IsInside(const std::array<int, 3>& p, const std::array<int, 3>& dims)
 {
     return (p[0] >= 0) && (p[0] < dims[0]) &&
@@ -50,6 +61,7 @@ std::uint32_t BlockColor(const BlockType type)
 
 VoxelChunkMesh VoxelMesher::BuildChunkMesh(const VoxelWorld& world, const int chunkX, const int chunkZ)
 {
+    RG_PROFILE_SCOPE("VoxelMesher::BuildChunkMesh");
     VoxelChunkMesh mesh;
     mesh.chunkX = chunkX;
     mesh.chunkZ = chunkZ;
@@ -63,6 +75,56 @@ VoxelChunkMesh VoxelMesher::BuildChunkMesh(const VoxelWorld& world, const int ch
         return world.GetBlock(baseX + local[0], local[1], baseZ + local[2]);
     };
 
+    // Faces only appear between a solid and a non-solid block, so a cell pair whose
+    // two blocks lie in uniform sections of the same solidity is not sampled. That
+    // skips open sky and buried stone, usually most of a chunk. Sections are looked
+    // up for this chunk and its four neighbors, plus one layer below and above the
+    // world, which read as air.
+    std::array<std::array<SectionFill, VoxelWorld::kSectionCount + 2>, 5> fills {};
+    const std::array<std::array<int, 2>, 5> offsets {{{0, 0}, {-1, 0}, {1, 0}, {0, -1}, {0, 1}}};
+    for (std::size_t neighbor = 0; neighbor < offsets.size(); ++neighbor)
+    {
+        for (int section = -1; section <= VoxelWorld::kSectionCount; ++section)
+        {
+            BlockType block = BlockType::Air;
+            SectionFill fill = SectionFill::Mixed;
+            if (world.IsSectionUniform(chunkX + offsets[neighbor][0], section, chunkZ + offsets[neighbor][1], &block))
+            {
+                fill = IsSolid(block) ? SectionFill::Solid : SectionFill::Empty;
+            }
+            fills[neighbor][static_cast<std::size_t>(section + 1)] = fill;
+        }
+    }
+    const auto fillAt = [&fills, &dims](const std::array<int, 3>& local)
+    {
+        std::size_t neighbor = 0;
+        if (local[0] < 0)
+        {
+            neighbor = 1;
+        }
+        else if (local[0] >= dims[0])
+        {
+            neighbor = 2;
+        }
+        else if (local[2] < 0)
+        {
+            neighbor = 3;
+        }
+        else if (local[2] >= dims[2])
+        {
+            neighbor = 4;
+        }
+
+        const int section = (local[1] < 0) ? -1 : std::min(local[1] / VoxelWorld::kSectionSize, VoxelWorld::kSectionCount);
+        return fills[neighbor][static_cast<std::size_t>(section + 1)];
+    };
+
+    // One scratch mask, sized for the largest slice, serves all three axes; it is
+    // frame memory, so building a mesh allocates nothing but the mesh itself.
+    const std::size_t maskSize = static_cast<std::size_t>(
+        std::max({dims[1] * dims[2], dims[2] * dims[0], dims[0] * dims[1]}));
+    std::pmr::vector<MaskCell> mask(maskSize, FrameAllocator::Shared().Resource());
+
     for (int d = 0; d < 3; ++d)
     {
         const int u = (d + 1) % 3;
@@ -72,8 +134,6 @@ VoxelChunkMesh VoxelMesher::BuildChunkMesh(const VoxelWorld& world, const int ch
         std::array<int, 3> q {0, 0, 0};
         q[d] = 1;
 
-        std::vector<MaskCell> mask(static_cast<std::size_t>(dims[u] * dims[v]));
-
         for (x[d] = -1; x[d] < dims[d];)
         {
             std::size_t n = 0;
@@ -84,12 +144,19 @@ VoxelChunkMesh VoxelMesher::BuildChunkMesh(const VoxelWorld& world, const int ch
                     const std::array<int, 3> a = x;
                     const std::array<int, 3> b = {x[0] + q[0], x[1] + q[1], x[2] + q[2]};
 
+                    MaskCell cell;
+                    const SectionFill fill = fillAt(a);
+                    if ((fill != SectionFill::Mixed) && (fill == fillAt(b)))
+                    {
+                        mask[n++] = cell;
+                        continue;
+                    }
+
                     const BlockType blockA = sampleBlock(a);
                     const BlockType blockB = sampleBlock(b);
                     const bool aSolid = IsSolid(blockA);
                     const bool bSolid = IsSolid(blockB);
 
-                    MaskCell cell;
                     if (aSolid && !bSolid && IsInside(a, dims))
                     {
                         cell.block = blockA;
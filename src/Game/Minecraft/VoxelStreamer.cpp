@@ -0,0 +1,290 @@
+#include "Game/Minecraft/VoxelStreamer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+#include "Engine/Core/Profiler.h"
+
+namespace rg::minecraft
+{
+namespace
+{
+// Chunks are evicted only this many chunks beyond the view distance, so walking
+// back and forth over a chunk border does not reload the same chunks.
+constexpr float kEvictionMargin = 1.0f;
+// Charge for a chunk before any is loaded to average over: one byte per block.
+constexpr std::size_t kChunkBytes = VoxelWorld::kChunkVolume;
+} // namespace
+
+VoxelStreamer::VoxelStreamer(VoxelStreamingSettings settings) : m_settings(settings)
+{
+    m_settings.viewDistanceInChunks = std::max(1, m_settings.viewDistanceInChunks);
+    m_settings.maxChunksInFlight = std::max<std::size_t>(1, m_settings.maxChunksInFlight);
+    m_settings.maxChunksPerUpdate = std::max<std::size_t>(1, m_settings.maxChunksPerUpdate);
+}
+
+VoxelStreamer::~VoxelStreamer()
+{
+    // Jobs write into this object; a failed job has nothing left to report to.
+    try
+    {
+        WaitIdle();
+    }
+    catch (...)
+    {
+    }
+}
+
+void VoxelStreamer::Update(VoxelWorld& world, const Vector3& viewerPosition, const Vector3& viewDirection)
+{
+    RG_PROFILE_SCOPE("VoxelStreamer::Update");
+    const Clock::time_point start = Clock::now();
+    const Clock::time_point deadline =
+        start + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double, std::milli>(m_settings.frameBudgetMs));
+    m_stats.integratedLastUpdate = 0;
+    m_stats.evictedLastUpdate = 0;
+
+    const float chunkSize = static_cast<float>(VoxelWorld::kChunkSize);
+    m_viewerX = viewerPosition.x / chunkSize;
+    m_viewerZ = viewerPosition.z / chunkSize;
+    const float viewLength = std::sqrt((viewDirection.x * viewDirection.x) + (viewDirection.z * viewDirection.z));
+    m_viewX = (viewLength > 0.0001f) ? (viewDirection.x / viewLength) : 0.0f;
+    m_viewZ = (viewLength > 0.0001f) ? (viewDirection.z / viewLength) : 0.0f;
+
+    const ChunkKey center {
+        VoxelWorld::ToChunkCoordinate(static_cast<int>(std::floor(viewerPosition.x))),
+        VoxelWorld::ToChunkCoordinate(static_cast<int>(std::floor(viewerPosition.z)))};
+    const bool moved = !m_hasCenter || (center.x != m_center.x) || (center.z != m_center.z);
+    m_center = center;
+    m_hasCenter = true;
+
+    // Something other than the streamer changed the world (an edit, a regenerate),
+    // or the ring moved: chunks may have to go and holes may have opened.
+    if (moved || (world.Revision() != m_scannedRevision))
+    {
+        EvictOutOfRange(world);
+        m_ringComplete = false;
+    }
+
+    // Without workers, spawned jobs only run on threads that help.
+    JobSystem& jobs = JobSystem::Shared();
+    if (jobs.WorkerCount() == 0)
+    {
+        while (!m_jobs.IsDone() && (Clock::now() < deadline) && jobs.RunPendingJob(m_jobs))
+        {
+        }
+    }
+
+    Integrate(world, deadline);
+    if (!m_ringComplete)
+    {
+        Schedule(world);
+    }
+    m_scannedRevision = world.Revision();
+
+    m_stats.loadedChunks = world.LoadedChunkCount();
+    m_stats.chunksInFlight = m_pending.size();
+    m_stats.memoryBytes = world.MemoryBytes();
+    m_stats.updateMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+void VoxelStreamer::WaitIdle()
+{
+    JobSystem::Shared().Wait(m_jobs);
+}
+
+const VoxelStreamingSettings& VoxelStreamer::Settings() const
+{
+    return m_settings;
+}
+
+const VoxelStreamingStats& VoxelStreamer::Stats() const
+{
+    return m_stats;
+}
+
+float VoxelStreamer::Distance(const ChunkKey& key) const
+{
+    const float dx = (static_cast<float>(key.x) + 0.5f) - m_viewerX;
+    const float dz = (static_cast<float>(key.z) + 0.5f) - m_viewerZ;
+    return std::sqrt((dx * dx) + (dz * dz));
+}
+
+float VoxelStreamer::Priority(const ChunkKey& key) const
+{
+    const float distance = Distance(key);
+    if (distance < 0.0001f)
+    {
+        return 0.0f;
+    }
+
+    const float dx = (static_cast<float>(key.x) + 0.5f) - m_viewerX;
+    const float dz = (static_cast<float>(key.z) + 0.5f) - m_viewerZ;
+    const float facing = ((dx * m_viewX) + (dz * m_viewZ)) / distance;
+    return distance * (1.0f + (0.5f * (1.0f - facing)));
+}
+
+bool VoxelStreamer::IsPending(const ChunkKey& key) const
+{
+    return std::any_of(m_pending.begin(), m_pending.end(), [&key](const ChunkKey& pending)
+    {
+        return (pending.x == key.x) && (pending.z == key.z);
+    });
+}
+
+void VoxelStreamer::RemovePending(const ChunkKey& key)
+{
+    const auto it = std::find_if(m_pending.begin(), m_pending.end(), [&key](const ChunkKey& pending)
+    {
+        return (pending.x == key.x) && (pending.z == key.z);
+    });
+    if (it != m_pending.end())
+    {
+        *it = m_pending.back();
+        m_pending.pop_back();
+    }
+}
+
+void VoxelStreamer::EvictOutOfRange(VoxelWorld& world)
+{
+    const float limit = static_cast<float>(m_settings.viewDistanceInChunks) + kEvictionMargin;
+    for (const auto& [chunkX, chunkZ] : world.ChunkCoordinates())
+    {
+        if (Distance(ChunkKey {chunkX, chunkZ}) > limit)
+        {
+            const bool removed = world.RemoveChunk(chunkX, chunkZ);
+            (void)removed;
+            ++m_stats.evictedLastUpdate;
+        }
+    }
+}
+
+void VoxelStreamer::Integrate(VoxelWorld& world, const Clock::time_point deadline)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_finishedMutex);
+        for (GeneratedChunk& generated : m_finished)
+        {
+            m_ready.push_back(std::move(generated));
+        }
+        m_finished.clear();
+    }
+
+    // At least one chunk per update, so a tight budget still makes progress.
+    const float limit = static_cast<float>(m_settings.viewDistanceInChunks) + kEvictionMargin;
+    std::size_t index = 0;
+    for (; index < m_ready.size(); ++index)
+    {
+        if ((m_stats.integratedLastUpdate >= m_settings.maxChunksPerUpdate) ||
+            ((index > 0) && (Clock::now() >= deadline)))
+        {
+            break;
+        }
+
+        GeneratedChunk& generated = m_ready[index];
+        RemovePending(generated.key);
+        // Stale results: the world was reset or regenerated, or the viewer moved on.
+        if ((generated.seed != world.Seed()) || world.HasChunk(generated.key.x, generated.key.z) ||
+            (Distance(generated.key) > limit))
+        {
+            continue;
+        }
+
+        world.InsertChunk(generated.key.x, generated.key.z, std::move(generated.chunk));
+        ++m_stats.integratedLastUpdate;
+    }
+    m_ready.erase(m_ready.begin(), m_ready.begin() + static_cast<std::ptrdiff_t>(index));
+}
+
+void VoxelStreamer::Schedule(VoxelWorld& world)
+{
+    if (m_pending.size() >= m_settings.maxChunksInFlight)
+    {
+        return;
+    }
+
+    const int radius = m_settings.viewDistanceInChunks;
+    const float viewDistance = static_cast<float>(radius);
+    std::vector<std::pair<float, ChunkKey>> candidates;
+    for (int chunkZ = m_center.z - radius - 1; chunkZ <= m_center.z + radius + 1; ++chunkZ)
+    {
+        for (int chunkX = m_center.x - radius - 1; chunkX <= m_center.x + radius + 1; ++chunkX)
+        {
+            const ChunkKey key {chunkX, chunkZ};
+            if ((Distance(key) > viewDistance) || world.HasChunk(chunkX, chunkZ) || IsPending(key))
+            {
+                continue;
+            }
+            candidates.emplace_back(Priority(key), key);
+        }
+    }
+
+    const std::size_t slots = m_settings.maxChunksInFlight - m_pending.size();
+    const std::size_t count = std::min(slots, candidates.size());
+    std::partial_sort(candidates.begin(), candidates.begin() + static_cast<std::ptrdiff_t>(count), candidates.end(), [](const auto& a, const auto& b)
+    {
+        return a.first < b.first;
+    });
+    // Once every missing chunk is queued, rescans wait for the next move or edit.
+    m_ringComplete = (candidates.size() <= slots);
+
+    // Chunks in flight are charged at the current average chunk size.
+    const std::size_t loaded = world.LoadedChunkCount();
+    std::size_t memory = world.MemoryBytes();
+    const std::size_t chunkBytes = (loaded > 0) ? std::max<std::size_t>(1, memory / loaded) : kChunkBytes;
+    memory += m_pending.size() * chunkBytes;
+
+    JobSystem& jobs = JobSystem::Shared();
+    for (std::size_t index = 0; index < count; ++index)
+    {
+        const auto& [priority, key] = candidates[index];
+        while ((memory + chunkBytes) > m_settings.memoryBudgetBytes)
+        {
+            // Out of memory for anything this far away; wait for the viewer to move.
+            if (!EvictWorseThan(world, priority))
+            {
+                m_ringComplete = true;
+                return;
+            }
+            memory -= std::min(memory, chunkBytes);
+        }
+
+        m_pending.push_back(key);
+        memory += chunkBytes;
+        const int seed = world.Seed();
+        jobs.Spawn(m_jobs, [this, key, seed]()
+        {
+            RG_PROFILE_SCOPE("VoxelStreamer::GenerateChunk");
+            GeneratedChunk generated {key, seed, VoxelWorld::GenerateChunk(key.x, key.z, seed)};
+            std::lock_guard<std::mutex> lock(m_finishedMutex);
+            m_finished.push_back(std::move(generated));
+        });
+    }
+}
+
+bool VoxelStreamer::EvictWorseThan(VoxelWorld& world, const float priority)
+{
+    ChunkKey worst;
+    float worstPriority = -1.0f;
+    for (const auto& [chunkX, chunkZ] : world.ChunkCoordinates())
+    {
+        const float candidate = Priority(ChunkKey {chunkX, chunkZ});
+        if (candidate > worstPriority)
+        {
+            worstPriority = candidate;
+            worst = ChunkKey {chunkX, chunkZ};
+        }
+    }
+
+    if (worstPriority <= (priority + kEvictionMargin))
+    {
+        return false;
+    }
+
+    const bool removed = world.RemoveChunk(worst.x, worst.z);
+    (void)removed;
+    ++m_stats.evictedLastUpdate;
+    return true;
+}
+} // namespace rg::minecraft
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include "Engine/Core/JobSystem.h"
+#include "Engine/Math/Vector3.h"
+#include "Game/Minecraft/VoxelWorld.h"
+
+namespace rg::minecraft
+{
+struct VoxelStreamingSettings
+{
+    // Chunks whose centers lie within this many chunks of the viewer are loaded.
+    int viewDistanceInChunks = 10;
+    // Upper bound on the block storage of loaded and in-flight chunks. When the
+    // ring does not fit, the chunks with the worst priority stay unloaded.
+    std::size_t memoryBudgetBytes = std::size_t {64} << 20U;
+    // Main-thread time per Update() spent integrating generated chunks.
+    double frameBudgetMs = 2.0;
+    // Chunks integrated per Update(). Each one also makes its four neighbors
+    // remesh, so this bounds the meshing work the next render extraction sees.
+    std::size_t maxChunksPerUpdate = 4;
+    // Chunks queued or being generated at once.
+    std::size_t maxChunksInFlight = 8;
+};
+
+struct VoxelStreamingStats
+{
+    std::size_t loadedChunks = 0;
+    std::size_t chunksInFlight = 0;
+    std::size_t memoryBytes = 0;
+    std::size_t integratedLastUpdate = 0;
+    std::size_t evictedLastUpdate = 0;
+    double updateMs = 0.0;
+};
+
+// Keeps a VoxelWorld loaded in a ring around a moving viewer. Missing chunks are
+// generated on the job system, nearest first and those ahead of the viewer before
+// those behind it; the main thread only moves finished chunks into the world,
+// within a time budget per Update(). Chunks that fall out of the ring, or that lose
+// their place to closer ones when memory is short, are evicted.
+class VoxelStreamer
+{
+public:
+    explicit VoxelStreamer(VoxelStreamingSettings settings = {});
+    ~VoxelStreamer();
+
+    VoxelStreamer(const VoxelStreamer&) = delete;
+    VoxelStreamer& operator=(const VoxelStreamer&) = delete;
+
+    // Call once per frame from the thread that owns the world.
+    void Update(VoxelWorld& world, const Vector3& viewerPosition, const Vector3& viewDirection);
+
+    // Blocks until every chunk in flight has been generated; they are integrated by
+    // the next Update().
+    void WaitIdle();
+
+    [[nodiscard]] const VoxelStreamingSettings& Settings() const;
+    [[nodiscard]] const VoxelStreamingStats& Stats() const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct ChunkKey
+    {
+        int x = 0;
+        int z = 0;
+    };
+
+    struct GeneratedChunk
+    {
+        ChunkKey key;
+        int seed = 0;
+        VoxelWorld::Chunk chunk;
+    };
+
+    // Lower is more urgent: distance from the viewer in chunks, up to doubled for
+    // chunks behind the view direction.
+    [[nodiscard]] float Priority(const ChunkKey& key) const;
+    [[nodiscard]] float Distance(const ChunkKey& key) const;
+    [[nodiscard]] bool IsPending(const ChunkKey& key) const;
+
+    void EvictOutOfRange(VoxelWorld& world);
+    void Integrate(VoxelWorld& world, Clock::time_point deadline);
+    void Schedule(VoxelWorld& world);
+    // Evicts the loaded chunk with the worst priority if it is worse than
+    // `priority` by more than the hysteresis margin.
+    bool EvictWorseThan(VoxelWorld& world, float priority);
+    void RemovePending(const ChunkKey& key);
+
+    VoxelStreamingSettings m_settings;
+    VoxelStreamingStats m_stats;
+
+    float m_viewerX = 0.0f;
+    float m_viewerZ = 0.0f;
+    float m_viewX = 0.0f;
+    float m_viewZ = 0.0f;
+    ChunkKey m_center;
+    bool m_hasCenter = false;
+    std::uint64_t m_scannedRevision = 0;
+    bool m_ringComplete = false;
+
+    JobCounter m_jobs;
+    std::mutex m_finishedMutex;
+    std::vector<GeneratedChunk> m_finished;
+    // Main thread only: finished chunks waiting for integration time.
+    std::vector<GeneratedChunk> m_ready;
+    // Chunks spawned and not yet integrated or discarded.
+    std::vector<ChunkKey> m_pending;
+};
+} // namespace rg::minecraft
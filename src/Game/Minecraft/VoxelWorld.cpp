@@ -2,13 +2,77 @@
 
 #include <algorithm>
 #include <cmath>
+#include <limits>
 #include <utility>
 
+#include "Engine/Core/JobSystem.h"
+#include "Engine/Core/Profiler.h"
+
 namespace rg::minecraft
 {
 namespace
 {
-constexpr float kRayStep = 0.1f;
+// Rays per job in RaycastMany; a short ray costs well under a microsecond.
+constexpr std::size_t kRaysPerJob = 64;
+// Leaves reach this far from the trunk horizontally.
+constexpr int kTreeCanopyRadius = 2;
+static_assert(VoxelWorld::kWorldHeight <= 256, "Chunk heightmaps store heights as bytes");
+
+// Advances a raycast's traversal state past the 16^3 box starting at boxMin, to
+// the first cell outside it. Returns false when that cell lies beyond maxDistance.
+bool SkipBox(const int (&boxMin)[3], int (&cell)[3], const int (&step)[3], float (&tMax)[3], const float (&tDelta)[3],
+    const float maxDistance, float& t, int& enteredAxis)
+{
+    constexpr int kBoxSize = VoxelWorld::kSectionSize;
+    static_assert(VoxelWorld::kChunkSize == VoxelWorld::kSectionSize, "Raycast skips cubic sections");
+
+    // Boundaries each axis still crosses inside the box, and the distance at
+    // which it leaves the box.
+    int crossings[3] = {};
+    float exitT[3] = {};
+    for (int axis = 0; axis < 3; ++axis)
+    {
+        if (step[axis] == 0)
+        {
+            exitT[axis] = std::numeric_limits<float>::infinity();
+            continue;
+        }
+        crossings[axis] = (step[axis] > 0) ? (boxMin[axis] + kBoxSize - 1 - cell[axis]) : (cell[axis] - boxMin[axis]);
+        exitT[axis] = tMax[axis] + static_cast<float>(crossings[axis]) * tDelta[axis];
+    }
+
+    int exitAxis = (exitT[0] < exitT[1]) ? 0 : 1;
+    exitAxis = (exitT[2] < exitT[exitAxis]) ? 2 : exitAxis;
+    if (exitT[exitAxis] > maxDistance)
+    {
+        return false;
+    }
+
+    // The other axes cross only the boundaries the ray reaches before it leaves.
+    // Stepping with the same additions as the cell walk keeps both paths in step.
+    for (int axis = 0; axis < 3; ++axis)
+    {
+        if (axis == exitAxis)
+        {
+            continue;
+        }
+        for (int crossing = 0; (crossing < crossings[axis]) && (tMax[axis] < exitT[exitAxis]); ++crossing)
+        {
+            cell[axis] += step[axis];
+            tMax[axis] += tDelta[axis];
+        }
+    }
+    for (int crossing = 0; crossing < crossings[exitAxis]; ++crossing)
+    {
+        cell[exitAxis] += step[exitAxis];
+        tMax[exitAxis] += tDelta[exitAxis];
+    }
+    t = tMax[exitAxis];
+    cell[exitAxis] += step[exitAxis];
+    tMax[exitAxis] += tDelta[exitAxis];
+    enteredAxis = exitAxis;
+    return true;
+}
 }
 
 bool IsSolid(const BlockType type)
@@ -41,20 +105,157 @@ const char* ToString(const BlockType type)
 
 void VoxelWorld::Generate(const int radiusInChunks, const int seed)
 {
+    RG_PROFILE_SCOPE("VoxelWorld::Generate");
     m_radiusInChunks = std::max(1, radiusInChunks);
     m_seed = seed;
+    MarkAllDirty();
     m_chunks.clear();
+    ++m_revision;
 
+    // The map is filled up front with empty chunks; workers then only touch their
+    // own chunk and allocate its blocks right before writing them.
+    const std::size_t side = static_cast<std::size_t>((2 * m_radiusInChunks) + 1);
+    m_chunks.reserve(side * side);
+    std::vector<std::pair<ChunkCoord, Chunk*>> chunks;
+    chunks.reserve(side * side);
     for (int chunkZ = -m_radiusInChunks; chunkZ <= m_radiusInChunks; ++chunkZ)
     {
         for (int chunkX = -m_radiusInChunks; chunkX <= m_radiusInChunks; ++chunkX)
         {
-            Chunk& chunk = EnsureChunk(chunkX, chunkZ);
-            GenerateChunk(ChunkCoord {chunkX, chunkZ}, chunk);
+            const ChunkCoord coord {chunkX, chunkZ};
+            Chunk& chunk = m_chunks[coord];
+            chunk.revision = m_revision;
+            chunks.emplace_back(coord, &chunk);
         }
     }
 
+    JobSystem::Shared().ParallelFor(chunks.size(), 1, [seed, &chunks](const std::size_t begin, const std::size_t end)
+    {
+        for (std::size_t index = begin; index < end; ++index)
+        {
+            FillChunk(chunks[index].first, seed, *chunks[index].second);
+        }
+    });
+    MarkAllDirty();
+}
+
+void VoxelWorld::Reset(const int seed)
+{
+    m_radiusInChunks = 0;
+    m_seed = seed;
+    MarkAllDirty();
+    m_chunks.clear();
+    ++m_revision;
+}
+
+VoxelWorld::Chunk VoxelWorld::GenerateChunk(const int chunkX, const int chunkZ, const int seed)
+{
+    Chunk chunk;
+    FillChunk(ChunkCoord {chunkX, chunkZ}, seed, chunk);
+    return chunk;
+}
+
+void VoxelWorld::InsertChunk(const int chunkX, const int chunkZ, Chunk chunk)
+{
     ++m_revision;
+    chunk.revision = m_revision;
+    m_chunks.insert_or_assign(ChunkCoord {chunkX, chunkZ}, std::move(chunk));
+    MarkDirty(chunkX, chunkZ);
+    TouchNeighbors(chunkX, chunkZ);
+}
+
+bool VoxelWorld::RemoveChunk(const int chunkX, const int chunkZ)
+{
+    if (m_chunks.erase(ChunkCoord {chunkX, chunkZ}) == 0)
+    {
+        return false;
+    }
+
+    ++m_revision;
+    MarkDirty(chunkX, chunkZ);
+    TouchNeighbors(chunkX, chunkZ);
+    return true;
+}
+
+bool VoxelWorld::HasChunk(const int chunkX, const int chunkZ) const
+{
+    return FindChunk(chunkX, chunkZ) != nullptr;
+}
+
+std::uint64_t VoxelWorld::ChunkRevision(const int chunkX, const int chunkZ) const
+{
+    const Chunk* chunk = FindChunk(chunkX, chunkZ);
+    return (chunk != nullptr) ? chunk->revision : 0U;
+}
+
+int VoxelWorld::ToChunkCoordinate(const int worldCoordinate)
+{
+    return FloorDiv(worldCoordinate, kChunkSize);
+}
+
+VoxelWorld::DirtyTrackerId VoxelWorld::RegisterDirtyTracker()
+{
+    const DirtyTrackerId tracker = m_nextDirtyTracker++;
+    std::unordered_set<ChunkCoord, ChunkCoordHasher>& dirty = m_dirtyChunks[tracker];
+    dirty.reserve(m_chunks.size());
+    for (const auto& entry : m_chunks)
+    {
+        dirty.insert(entry.first);
+    }
+    return tracker;
+}
+
+void VoxelWorld::UnregisterDirtyTracker(const DirtyTrackerId tracker)
+{
+    m_dirtyChunks.erase(tracker);
+}
+
+void VoxelWorld::DrainDirtyChunks(const DirtyTrackerId tracker, std::vector<std::pair<int, int>>& outChunks)
+{
+    outChunks.clear();
+    const auto it = m_dirtyChunks.find(tracker);
+    if (it == m_dirtyChunks.end())
+    {
+        return;
+    }
+
+    outChunks.reserve(it->second.size());
+    for (const ChunkCoord& coord : it->second)
+    {
+        outChunks.emplace_back(coord.x, coord.z);
+    }
+    it->second.clear();
+}
+
+bool VoxelWorld::IsSectionUniform(const int chunkX, const int sectionY, const int chunkZ, BlockType* outBlock) const
+{
+    const Chunk* chunk = FindChunk(chunkX, chunkZ);
+    if ((chunk == nullptr) || (sectionY < 0) || (sectionY >= kSectionCount))
+    {
+        if (outBlock != nullptr)
+        {
+            *outBlock = BlockType::Air;
+        }
+        return true;
+    }
+
+    const PalettedBlockStorage& section = chunk->sections[static_cast<std::size_t>(sectionY)];
+    if (!section.IsUniform())
+    {
+        return false;
+    }
+
+    if (outBlock != nullptr)
+    {
+        *outBlock = static_cast<BlockType>(section.UniformValue());
+    }
+    return true;
+}
+
+bool VoxelWorld::IsSectionEmpty(const int chunkX, const int sectionY, const int chunkZ) const
+{
+    BlockType block = BlockType::Air;
+    return IsSectionUniform(chunkX, sectionY, chunkZ, &block) && (block == BlockType::Air);
 }
 
 BlockType VoxelWorld::GetBlock(const int x, const int y, const int z) const
@@ -74,7 +275,7 @@ BlockType VoxelWorld::GetBlock(const int x, const int y, const int z) const
 
     const int localX = PositiveMod(x, kChunkSize);
     const int localZ = PositiveMod(z, kChunkSize);
-    return static_cast<BlockType>(chunk->blocks[Index(localX, y, localZ)]);
+    return static_cast<BlockType>(chunk->sections[y / kSectionSize].Get(Index(localX, y % kSectionSize, localZ)));
 }
 
 bool VoxelWorld::SetBlock(const int x, const int y, const int z, const BlockType type)
@@ -86,98 +287,508 @@ bool VoxelWorld::SetBlock(const int x, const int y, const int z, const BlockType
 
     const int chunkX = FloorDiv(x, kChunkSize);
     const int chunkZ = FloorDiv(z, kChunkSize);
-    Chunk& chunk = EnsureChunk(chunkX, chunkZ);
+    Chunk* chunk = FindChunk(chunkX, chunkZ);
+    if (chunk == nullptr)
+    {
+        return false;
+    }
 
     const int localX = PositiveMod(x, kChunkSize);
     const int localZ = PositiveMod(z, kChunkSize);
-    const std::size_t index = Index(localX, y, localZ);
+    PalettedBlockStorage& section = chunk->sections[y / kSectionSize];
+    const std::size_t index = Index(localX, y % kSectionSize, localZ);
     const std::uint8_t value = static_cast<std::uint8_t>(type);
 
-    if (chunk.blocks[index] == value)
+    if (section.Get(index) == value)
     {
         return false;
     }
 
-    chunk.blocks[index] = value;
+    section.Set(index, value);
+    std::uint8_t& height = chunk->heights[ColumnIndex(localX, localZ)];
+    if (IsSolid(type))
+    {
+        height = std::max(height, static_cast<std::uint8_t>(y));
+    }
+    else if (y == height)
+    {
+        height = static_cast<std::uint8_t>(ScanColumn(*chunk, localX, localZ, y - 1));
+    }
     ++m_revision;
+    chunk->revision = m_revision;
+    MarkDirty(chunkX, chunkZ);
+    // Border blocks also decide which faces the neighbor draws.
+    if (localX == 0)
+    {
+        TouchChunk(chunkX - 1, chunkZ);
+    }
+    else if (localX == kChunkSize - 1)
+    {
+        TouchChunk(chunkX + 1, chunkZ);
+    }
+    if (localZ == 0)
+    {
+        TouchChunk(chunkX, chunkZ - 1);
+    }
+    else if (localZ == kChunkSize - 1)
+    {
+        TouchChunk(chunkX, chunkZ + 1);
+    }
     return true;
 }
 
-int VoxelWorld::SurfaceHeight(const int x, const int z) const
+template <typename EditFunc>
+std::size_t VoxelWorld::EditRegion(int x0, int y0, int z0, int x1, int y1, int z1, const EditFunc& edit)
 {
-    for (int y = kWorldHeight - 1; y >= 0; --y)
+    const int minX = std::min(x0, x1);
+    const int maxX = std::max(x0, x1);
+    const int minY = std::max(std::min(y0, y1), 0);
+    const int maxY = std::min(std::max(y0, y1), kWorldHeight - 1);
+    const int minZ = std::min(z0, z1);
+    const int maxZ = std::max(z0, z1);
+    if (minY > maxY)
     {
-        if (IsSolid(GetBlock(x, y, z)))
+        return 0;
+    }
+
+    // Each touched section is unpacked, edited as a plain array and packed again,
+    // which also narrows it when the edit made it simpler (a dug-out section
+    // becomes uniform air again).
+    // Boxes spanning more chunk columns than are loaded walk the loaded chunks
+    // instead, so the cost never exceeds the world's size.
+    const int minChunkX = FloorDiv(minX, kChunkSize);
+    const int maxChunkX = FloorDiv(maxX, kChunkSize);
+    const int minChunkZ = FloorDiv(minZ, kChunkSize);
+    const int maxChunkZ = FloorDiv(maxZ, kChunkSize);
+    const std::int64_t columns = (static_cast<std::int64_t>(maxChunkX) - minChunkX + 1) * (static_cast<std::int64_t>(maxChunkZ) - minChunkZ + 1);
+    std::vector<std::pair<ChunkCoord, Chunk*>> chunks;
+    if (columns > static_cast<std::int64_t>(m_chunks.size()))
+    {
+        for (auto& [coord, chunk] : m_chunks)
         {
-            return y;
+            if ((coord.x >= minChunkX) && (coord.x <= maxChunkX) && (coord.z >= minChunkZ) && (coord.z <= maxChunkZ))
+            {
+                chunks.emplace_back(coord, &chunk);
+            }
         }
     }
-    return 0;
+    else
+    {
+        for (int chunkZ = minChunkZ; chunkZ <= maxChunkZ; ++chunkZ)
+        {
+            for (int chunkX = minChunkX; chunkX <= maxChunkX; ++chunkX)
+            {
+                if (Chunk* chunk = FindChunk(chunkX, chunkZ); chunk != nullptr)
+                {
+                    chunks.emplace_back(ChunkCoord {chunkX, chunkZ}, chunk);
+                }
+            }
+        }
+    }
+
+    std::array<std::uint8_t, kSectionVolume> blocks {};
+    std::vector<EditedChunk> edited;
+    std::size_t changed = 0;
+    for (const auto& [coord, chunk] : chunks)
+    {
+        const int originX = coord.x * kChunkSize;
+        const int originZ = coord.z * kChunkSize;
+        const int localMinX = std::max(minX, originX) - originX;
+        const int localMaxX = std::min(maxX, originX + kChunkSize - 1) - originX;
+        const int localMinZ = std::max(minZ, originZ) - originZ;
+        const int localMaxZ = std::min(maxZ, originZ + kChunkSize - 1) - originZ;
+
+        EditedChunk current;
+        current.coord = coord;
+        current.chunk = chunk;
+        for (int sectionY = minY / kSectionSize; sectionY <= maxY / kSectionSize; ++sectionY)
+        {
+            const int originY = sectionY * kSectionSize;
+            const int localMinY = std::max(minY, originY) - originY;
+            const int localMaxY = std::min(maxY, originY + kSectionSize - 1) - originY;
+            PalettedBlockStorage& section = chunk->sections[static_cast<std::size_t>(sectionY)];
+            section.Unpack(blocks.data());
+
+            const std::size_t before = current.changedBlocks;
+            for (int y = localMinY; y <= localMaxY; ++y)
+            {
+                for (int localZ = localMinZ; localZ <= localMaxZ; ++localZ)
+                {
+                    std::size_t index = Index(localMinX, y, localZ);
+                    for (int localX = localMinX; localX <= localMaxX; ++localX, ++index)
+                    {
+                        const BlockType block = static_cast<BlockType>(blocks[index]);
+                        const BlockType result = edit(originX + localX, originY + y, originZ + localZ, block);
+                        if (result != block)
+                        {
+                            blocks[index] = static_cast<std::uint8_t>(result);
+                            NoteEdit(current, localX, originY + y, localZ, result);
+                        }
+                    }
+                }
+            }
+
+            if (current.changedBlocks != before)
+            {
+                section.Assign(blocks.data(), kSectionVolume);
+            }
+        }
+
+        if (current.changedBlocks > 0)
+        {
+            changed += current.changedBlocks;
+            edited.push_back(current);
+        }
+    }
+
+    CommitEdits(edited);
+    return changed;
 }
 
-bool VoxelWorld::Raycast(const Vector3& origin, const Vector3& direction, const float maxDistance, BlockHit& outHit) const
+std::size_t VoxelWorld::FillBox(const int x0, const int y0, const int z0, const int x1, const int y1, const int z1, const BlockType type)
 {
-    const float directionLength = direction.Length();
-    if ((directionLength < 0.0001f) || (maxDistance <= 0.0f))
+    RG_PROFILE_SCOPE("VoxelWorld::FillBox");
+    return EditRegion(x0, y0, z0, x1, y1, z1, [type](int, int, int, BlockType)
     {
-        outHit = {};
-        return false;
+        return type;
+    });
+}
+
+std::size_t VoxelWorld::FillSphere(const Vector3& center, const float radius, const BlockType type)
+{
+    RG_PROFILE_SCOPE("VoxelWorld::FillSphere");
+    if (!std::isfinite(radius) || (radius <= 0.0f) || !std::isfinite(center.x) || !std::isfinite(center.y) ||
+        !std::isfinite(center.z))
+    {
+        return 0;
     }
 
-    const float invLength = 1.0f / directionLength;
-    const float dirX = direction.x * invLength;
-    const float dirY = direction.y * invLength;
-    const float dirZ = direction.z * invLength;
+    // Bounds far outside the int range are clamped to it; EditRegion then only
+    // visits loaded chunks.
+    const auto toBlock = [](const float value)
+    {
+        const double block = std::floor(static_cast<double>(value));
+        return static_cast<int>(std::clamp(
+            block,
+            static_cast<double>(std::numeric_limits<int>::min()),
+            static_cast<double>(std::numeric_limits<int>::max())));
+    };
+    const float radiusSquared = radius * radius;
+    return EditRegion(
+        toBlock(center.x - radius),
+        toBlock(center.y - radius),
+        toBlock(center.z - radius),
+        toBlock(center.x + radius),
+        toBlock(center.y + radius),
+        toBlock(center.z + radius),
+        [&center, radiusSquared, type](const int x, const int y, const int z, const BlockType block)
+        {
+            const float dx = (static_cast<float>(x) + 0.5f) - center.x;
+            const float dy = (static_cast<float>(y) + 0.5f) - center.y;
+            const float dz = (static_cast<float>(z) + 0.5f) - center.z;
+            return (((dx * dx) + (dy * dy) + (dz * dz)) <= radiusSquared) ? type : block;
+        });
+}
 
-    int previousX = static_cast<int>(std::floor(origin.x));
-    int previousY = static_cast<int>(std::floor(origin.y));
-    int previousZ = static_cast<int>(std::floor(origin.z));
+std::size_t VoxelWorld::ReplaceInRegion(
+    const int x0,
+    const int y0,
+    const int z0,
+    const int x1,
+    const int y1,
+    const int z1,
+    const BlockType from,
+    const BlockType to)
+{
+    RG_PROFILE_SCOPE("VoxelWorld::ReplaceInRegion");
+    return EditRegion(x0, y0, z0, x1, y1, z1, [from, to](int, int, int, const BlockType block)
+    {
+        return (block == from) ? to : block;
+    });
+}
 
-    for (float t = 0.0f; t <= maxDistance; t += kRayStep)
+std::size_t VoxelWorld::EditBatch(const std::vector<BlockEdit>& edits)
+{
+    RG_PROFILE_SCOPE("VoxelWorld::EditBatch");
+    // Edits are applied in order. Brushes and structures come in runs inside one
+    // chunk, so the chunk is looked up only when the run moves to another one.
+    std::vector<EditedChunk> edited;
+    std::unordered_map<ChunkCoord, std::size_t, ChunkCoordHasher> editedIndex;
+    ChunkCoord currentCoord;
+    EditedChunk* current = nullptr;
+    bool hasCurrent = false;
+    std::size_t changed = 0;
+    for (const BlockEdit& edit : edits)
     {
-        const float px = origin.x + (dirX * t);
-        const float py = origin.y + (dirY * t);
-        const float pz = origin.z + (dirZ * t);
+        if ((edit.y < 0) || (edit.y >= kWorldHeight))
+        {
+            continue;
+        }
 
-        const int x = static_cast<int>(std::floor(px));
-        const int y = static_cast<int>(std::floor(py));
-        const int z = static_cast<int>(std::floor(pz));
+        const ChunkCoord coord {FloorDiv(edit.x, kChunkSize), FloorDiv(edit.z, kChunkSize)};
+        if (!hasCurrent || !(coord == currentCoord))
+        {
+            hasCurrent = true;
+            currentCoord = coord;
+            current = nullptr;
+            const auto it = editedIndex.find(coord);
+            if (it != editedIndex.end())
+            {
+                current = &edited[it->second];
+            }
+            else if (Chunk* chunk = FindChunk(coord.x, coord.z); chunk != nullptr)
+            {
+                editedIndex.emplace(coord, edited.size());
+                current = &edited.emplace_back();
+                current->coord = coord;
+                current->chunk = chunk;
+            }
+        }
+        if (current == nullptr)
+        {
+            continue;
+        }
 
-        const BlockType block = GetBlock(x, y, z);
-        if (block != BlockType::Air)
+        const int localX = PositiveMod(edit.x, kChunkSize);
+        const int localZ = PositiveMod(edit.z, kChunkSize);
+        PalettedBlockStorage& section = current->chunk->sections[edit.y / kSectionSize];
+        const std::size_t index = Index(localX, edit.y % kSectionSize, localZ);
+        const std::uint8_t value = static_cast<std::uint8_t>(edit.type);
+        if (section.Get(index) == value)
         {
-            outHit.hit = true;
-            outHit.x = x;
-            outHit.y = y;
-            outHit.z = z;
-            outHit.block = block;
-            outHit.distance = t;
+            continue;
+        }
 
-            outHit.normalX = previousX - x;
-            outHit.normalY = previousY - y;
-            outHit.normalZ = previousZ - z;
+        section.Set(index, value);
+        NoteEdit(*current, localX, edit.y, localZ, edit.type);
+        ++changed;
+    }
 
-            if ((outHit.normalX == 0) && (outHit.normalY == 0) && (outHit.normalZ == 0))
+    // Chunks looked up but left unchanged need no bookkeeping.
+    edited.erase(std::remove_if(edited.begin(), edited.end(), [](const EditedChunk& entry)
+    {
+        return entry.changedBlocks == 0;
+    }), edited.end());
+    CommitEdits(edited);
+    return changed;
+}
+
+void VoxelWorld::NoteEdit(EditedChunk& edited, const int localX, const int y, const int localZ, const BlockType type)
+{
+    ++edited.changedBlocks;
+    // Heights move up right away; a removed top block leaves the column to be
+    // rescanned once the sections are written back.
+    const std::size_t column = ColumnIndex(localX, localZ);
+    std::uint8_t& height = edited.chunk->heights[column];
+    if (IsSolid(type))
+    {
+        height = std::max(height, static_cast<std::uint8_t>(y));
+    }
+    else if (y == height)
+    {
+        edited.rescanColumns[column] = true;
+    }
+    edited.westBorder = edited.westBorder || (localX == 0);
+    edited.eastBorder = edited.eastBorder || (localX == kChunkSize - 1);
+    edited.northBorder = edited.northBorder || (localZ == 0);
+    edited.southBorder = edited.southBorder || (localZ == kChunkSize - 1);
+}
+
+void VoxelWorld::CommitEdits(const std::vector<EditedChunk>& edited)
+{
+    if (edited.empty())
+    {
+        return;
+    }
+
+    ++m_revision;
+    for (const EditedChunk& entry : edited)
+    {
+        for (int localZ = 0; localZ < kChunkSize; ++localZ)
+        {
+            for (int localX = 0; localX < kChunkSize; ++localX)
             {
-                outHit.normalY = 1;
+                const std::size_t column = ColumnIndex(localX, localZ);
+                if (entry.rescanColumns[column])
+                {
+                    entry.chunk->heights[column] = static_cast<std::uint8_t>(ScanColumn(*entry.chunk, localX, localZ, kWorldHeight - 1));
+                }
+            }
+        }
+
+        entry.chunk->revision = m_revision;
+        MarkDirty(entry.coord.x, entry.coord.z);
+        // Border blocks also decide which faces the neighbor draws.
+        if (entry.westBorder)
+        {
+            TouchChunk(entry.coord.x - 1, entry.coord.z);
+        }
+        if (entry.eastBorder)
+        {
+            TouchChunk(entry.coord.x + 1, entry.coord.z);
+        }
+        if (entry.northBorder)
+        {
+            TouchChunk(entry.coord.x, entry.coord.z - 1);
+        }
+        if (entry.southBorder)
+        {
+            TouchChunk(entry.coord.x, entry.coord.z + 1);
+        }
+    }
+}
+
+int VoxelWorld::SurfaceHeight(const int x, const int z) const
+{
+    const Chunk* chunk = FindChunk(FloorDiv(x, kChunkSize), FloorDiv(z, kChunkSize));
+    if (chunk == nullptr)
+    {
+        return 0;
+    }
+    return chunk->heights[ColumnIndex(PositiveMod(x, kChunkSize), PositiveMod(z, kChunkSize))];
+}
+
+bool VoxelWorld::Raycast(const Vector3& origin, const Vector3& direction, const float maxDistance, BlockHit& outHit) const
+{
+    outHit = {};
+    // A NaN or infinite input would never reach maxDistance and walk cells forever.
+    if (!std::isfinite(maxDistance) || !std::isfinite(origin.x) || !std::isfinite(origin.y) || !std::isfinite(origin.z) ||
+        !std::isfinite(direction.x) || !std::isfinite(direction.y) || !std::isfinite(direction.z))
+    {
+        return false;
+    }
+    const float directionLength = direction.Length();
+    if ((directionLength < 0.0001f) || (maxDistance <= 0.0f))
+    {
+        return false;
+    }
+
+    // Amanatides-Woo traversal: every cell the ray passes through is visited once,
+    // in order. tMax is the ray distance to the next boundary on each axis, tDelta
+    // the distance between two boundaries.
+    const float start[3] = {origin.x, origin.y, origin.z};
+    const float dir[3] = {direction.x / directionLength, direction.y / directionLength, direction.z / directionLength};
+    int cell[3] = {};
+    int step[3] = {};
+    float tMax[3] = {};
+    float tDelta[3] = {};
+    for (int axis = 0; axis < 3; ++axis)
+    {
+        cell[axis] = static_cast<int>(std::floor(start[axis]));
+        if (dir[axis] > 0.0f)
+        {
+            step[axis] = 1;
+            tDelta[axis] = 1.0f / dir[axis];
+            tMax[axis] = (static_cast<float>(cell[axis] + 1) - start[axis]) * tDelta[axis];
+        }
+        else if (dir[axis] < 0.0f)
+        {
+            step[axis] = -1;
+            tDelta[axis] = -1.0f / dir[axis];
+            tMax[axis] = (start[axis] - static_cast<float>(cell[axis])) * tDelta[axis];
+        }
+        else
+        {
+            tDelta[axis] = std::numeric_limits<float>::infinity();
+            tMax[axis] = std::numeric_limits<float>::infinity();
+        }
+    }
+
+    // The chunk and section under the ray only change at their borders, so they are
+    // looked up once per crossing rather than once per cell.
+    const Chunk* chunk = nullptr;
+    int chunkX = 0;
+    int chunkZ = 0;
+    bool chunkCached = false;
+    int enteredAxis = -1;
+    float t = 0.0f;
+    while (true)
+    {
+        const int y = cell[1];
+        if ((y >= 0) && (y < kWorldHeight))
+        {
+            const int currentChunkX = FloorDiv(cell[0], kChunkSize);
+            const int currentChunkZ = FloorDiv(cell[2], kChunkSize);
+            if (!chunkCached || (currentChunkX != chunkX) || (currentChunkZ != chunkZ))
+            {
+                chunk = FindChunk(currentChunkX, currentChunkZ);
+                chunkX = currentChunkX;
+                chunkZ = currentChunkZ;
+                chunkCached = true;
+            }
+
+            const PalettedBlockStorage* section = (chunk != nullptr) ? &chunk->sections[static_cast<std::size_t>(y / kSectionSize)] : nullptr;
+            if ((section != nullptr) && !(section->IsUniform() && (section->UniformValue() == static_cast<std::uint8_t>(BlockType::Air))))
+            {
+                const BlockType block = static_cast<BlockType>(
+                    section->Get(Index(PositiveMod(cell[0], kChunkSize), y % kSectionSize, PositiveMod(cell[2], kChunkSize))));
+                if (IsSolid(block))
+                {
+                    outHit.hit = true;
+                    outHit.x = cell[0];
+                    outHit.y = y;
+                    outHit.z = cell[2];
+                    outHit.block = block;
+                    outHit.distance = t;
+                    // The face the ray came in through; a ray that starts inside a
+                    // block reports the top face.
+                    if (enteredAxis < 0)
+                    {
+                        outHit.normalY = 1;
+                    }
+                    else
+                    {
+                        int* normal[3] = {&outHit.normalX, &outHit.normalY, &outHit.normalZ};
+                        *normal[enteredAxis] = -step[enteredAxis];
+                    }
+                    return true;
+                }
             }
             else
             {
-                outHit.normalX = std::clamp(outHit.normalX, -1, 1);
-                outHit.normalY = std::clamp(outHit.normalY, -1, 1);
-                outHit.normalZ = std::clamp(outHit.normalZ, -1, 1);
+                // An unloaded chunk or an empty section holds nothing to hit, so the
+                // ray jumps straight to where it leaves this 16^3 box.
+                const int boxMin[3] = {chunkX * kChunkSize, (y / kSectionSize) * kSectionSize, chunkZ * kChunkSize};
+                if (!SkipBox(boxMin, cell, step, tMax, tDelta, maxDistance, t, enteredAxis))
+                {
+                    return false;
+                }
+                continue;
             }
+        }
+        else if (((y < 0) && (step[1] <= 0)) || ((y >= kWorldHeight) && (step[1] >= 0)))
+        {
+            // Outside the world height and not heading back in.
+            return false;
+        }
 
-            return true;
+        int axis = (tMax[0] < tMax[1]) ? 0 : 1;
+        axis = (tMax[2] < tMax[axis]) ? 2 : axis;
+        if (tMax[axis] > maxDistance)
+        {
+            return false;
         }
 
-        previousX = x;
-        previousY = y;
-        previousZ = z;
+        t = tMax[axis];
+        cell[axis] += step[axis];
+        tMax[axis] += tDelta[axis];
+        enteredAxis = axis;
     }
+}
 
-    outHit = {};
-    return false;
+void VoxelWorld::RaycastMany(const std::vector<VoxelRay>& rays, std::vector<BlockHit>& outHits) const
+{
+    RG_PROFILE_SCOPE("VoxelWorld::RaycastMany");
+    outHits.resize(rays.size());
+    JobSystem::Shared().ParallelFor(rays.size(), kRaysPerJob, [this, &rays, &outHits](const std::size_t begin, const std::size_t end)
+    {
+        for (std::size_t index = begin; index < end; ++index)
+        {
+            const VoxelRay& ray = rays[index];
+            const bool hit = Raycast(ray.origin, ray.direction, ray.maxDistance, outHits[index]);
+            (void)hit;
+        }
+    });
 }
 
 std::size_t VoxelWorld::LoadedChunkCount() const
@@ -185,6 +796,20 @@ std::size_t VoxelWorld::LoadedChunkCount() const
     return m_chunks.size();
 }
 
+std::size_t VoxelWorld::MemoryBytes() const
+{
+    std::size_t bytes = 0;
+    for (const auto& entry : m_chunks)
+    {
+        for (const PalettedBlockStorage& section : entry.second.sections)
+        {
+            bytes += section.MemoryBytes();
+        }
+        bytes += entry.second.heights.size();
+    }
+    return bytes;
+}
+
 std::vector<std::pair<int, int>> VoxelWorld::ChunkCoordinates() const
 {
     std::vector<std::pair<int, int>> out;
@@ -260,6 +885,34 @@ std::size_t VoxelWorld::Index(const int localX, const int y, const int localZ)
     return static_cast<std::size_t>((y * kChunkSize * kChunkSize) + (localZ * kChunkSize) + localX);
 }
 
+std::size_t VoxelWorld::ColumnIndex(const int localX, const int localZ)
+{
+    return static_cast<std::size_t>((localZ * kChunkSize) + localX);
+}
+
+int VoxelWorld::ScanColumn(const Chunk& chunk, const int localX, const int localZ, const int maxY)
+{
+    for (int y = maxY; y >= 0; --y)
+    {
+        const PalettedBlockStorage& section = chunk.sections[y / kSectionSize];
+        if (section.IsUniform())
+        {
+            if (section.UniformValue() != static_cast<std::uint8_t>(BlockType::Air))
+            {
+                return y;
+            }
+            y -= y % kSectionSize;
+            continue;
+        }
+
+        if (IsSolid(static_cast<BlockType>(section.Get(Index(localX, y % kSectionSize, localZ)))))
+        {
+            return y;
+        }
+    }
+    return 0;
+}
+
 std::uint32_t VoxelWorld::Hash2D(const int x, const int z, const int seed)
 {
     std::uint32_t h = static_cast<std::uint32_t>(seed);
@@ -285,23 +938,71 @@ VoxelWorld::Chunk* VoxelWorld::FindChunk(const int chunkX, const int chunkZ)
     return (it != m_chunks.end()) ? &it->second : nullptr;
 }
 
-VoxelWorld::Chunk& VoxelWorld::EnsureChunk(const int chunkX, const int chunkZ)
+void VoxelWorld::TouchChunk(const int chunkX, const int chunkZ)
 {
-    const ChunkCoord coord {chunkX, chunkZ};
-    const auto it = m_chunks.find(coord);
-    if (it != m_chunks.end())
+    Chunk* chunk = FindChunk(chunkX, chunkZ);
+    if (chunk != nullptr)
     {
-        return it->second;
+        chunk->revision = m_revision;
+        MarkDirty(chunkX, chunkZ);
     }
+}
 
-    Chunk chunk;
-    chunk.blocks.assign(static_cast<std::size_t>(kChunkSize * kWorldHeight * kChunkSize), static_cast<std::uint8_t>(BlockType::Air));
-    auto [inserted, ignored] = m_chunks.emplace(coord, std::move(chunk));
-    (void)ignored;
-    return inserted->second;
+void VoxelWorld::MarkDirty(const int chunkX, const int chunkZ)
+{
+    for (auto& entry : m_dirtyChunks)
+    {
+        entry.second.insert(ChunkCoord {chunkX, chunkZ});
+    }
+}
+
+void VoxelWorld::MarkAllDirty()
+{
+    for (auto& entry : m_dirtyChunks)
+    {
+        for (const auto& chunk : m_chunks)
+        {
+            entry.second.insert(chunk.first);
+        }
+    }
+}
+
+void VoxelWorld::TouchNeighbors(const int chunkX, const int chunkZ)
+{
+    TouchChunk(chunkX - 1, chunkZ);
+    TouchChunk(chunkX + 1, chunkZ);
+    TouchChunk(chunkX, chunkZ - 1);
+    TouchChunk(chunkX, chunkZ + 1);
+}
+
+void VoxelWorld::FillChunk(const ChunkCoord& coord, const int seed, Chunk& chunk)
+{
+    // Generation writes every block, so it works on a plain array per thread.
+    thread_local std::vector<std::uint8_t> blocks;
+    blocks.resize(kChunkVolume);
+    GenerateTerrain(coord, seed, blocks);
+    DecorateChunk(coord, seed, blocks);
+    for (int section = 0; section < kSectionCount; ++section)
+    {
+        chunk.sections[static_cast<std::size_t>(section)].Assign(
+            blocks.data() + (static_cast<std::size_t>(section) * kSectionVolume), kSectionVolume);
+    }
+
+    for (int localZ = 0; localZ < kChunkSize; ++localZ)
+    {
+        for (int localX = 0; localX < kChunkSize; ++localX)
+        {
+            int y = kWorldHeight - 1;
+            while ((y > 0) && !IsSolid(static_cast<BlockType>(blocks[Index(localX, y, localZ)])))
+            {
+                --y;
+            }
+            chunk.heights[ColumnIndex(localX, localZ)] = static_cast<std::uint8_t>(y);
+        }
+    }
 }
 
-void VoxelWorld::GenerateChunk(const ChunkCoord& coord, Chunk& chunk)
+void VoxelWorld::GenerateTerrain(const ChunkCoord& coord, const int seed, std::vector<std::uint8_t>& blocks)
 {
     for (int localZ = 0; localZ < kChunkSize; ++localZ)
     {
@@ -309,7 +1010,7 @@ void VoxelWorld::GenerateChunk(const ChunkCoord& coord, Chunk& chunk)
         {
             const int worldX = (coord.x * kChunkSize) + localX;
             const int worldZ = (coord.z * kChunkSize) + localZ;
-            const int surface = ComputeTerrainHeight(worldX, worldZ);
+            const int surface = ComputeTerrainHeight(worldX, worldZ, seed);
 
             for (int y = 0; y < kWorldHeight; ++y)
             {
@@ -330,45 +1031,78 @@ void VoxelWorld::GenerateChunk(const ChunkCoord& coord, Chunk& chunk)
                     }
                 }
 
-                chunk.blocks[Index(localX, y, localZ)] = static_cast<std::uint8_t>(block);
+                blocks[Index(localX, y, localZ)] = static_cast<std::uint8_t>(block);
             }
+        }
+    }
+}
+
+void VoxelWorld::DecorateChunk(const ChunkCoord& coord, const int seed, std::vector<std::uint8_t>& blocks)
+{
+    // Trees are placed by their trunk column, which may lie in a neighboring chunk
+    // when the canopy overhangs this one. Every chunk therefore scans the columns
+    // around it and keeps only the blocks inside itself, so a tree split across
+    // chunks comes out the same no matter which chunk is generated first.
+    const int minX = coord.x * kChunkSize;
+    const int minZ = coord.z * kChunkSize;
+    const auto place = [&blocks, minX, minZ](const int worldX, const int y, const int worldZ, const BlockType block, const bool onlyIntoAir)
+    {
+        const int localX = worldX - minX;
+        const int localZ = worldZ - minZ;
+        if ((localX < 0) || (localX >= kChunkSize) || (localZ < 0) || (localZ >= kChunkSize) || (y < 0) || (y >= kWorldHeight))
+        {
+            return;
+        }
+
+        std::uint8_t& cell = blocks[Index(localX, y, localZ)];
+        if (!onlyIntoAir || (cell == static_cast<std::uint8_t>(BlockType::Air)))
+        {
+            cell = static_cast<std::uint8_t>(block);
+        }
+    };
 
-            const std::uint32_t treeNoise = Hash2D(worldX, worldZ, m_seed + 91);
-            if ((surface > 10) && ((treeNoise % 97U) == 0U))
+    // Trunks first: leaves never replace wood, whichever tree they belong to.
+    for (int localZ = 0; localZ < kChunkSize; ++localZ)
+    {
+        for (int localX = 0; localX < kChunkSize; ++localX)
+        {
+            const int worldX = minX + localX;
+            const int worldZ = minZ + localZ;
+            int surface = 0;
+            if (!FindTree(worldX, worldZ, seed, surface))
             {
-                for (int trunk = 1; trunk <= 4; ++trunk)
-                {
-                    const int ty = surface + trunk;
-                    if (ty < kWorldHeight)
-                    {
-                        const bool changed = SetBlock(worldX, ty, worldZ, BlockType::Wood);
-                        (void)changed;
-                    }
-                }
+                continue;
+            }
+
+            for (int trunk = 1; trunk <= 4; ++trunk)
+            {
+                place(worldX, surface + trunk, worldZ, BlockType::Wood, false);
+            }
+        }
+    }
+
+    for (int worldZ = minZ - kTreeCanopyRadius; worldZ < minZ + kChunkSize + kTreeCanopyRadius; ++worldZ)
+    {
+        for (int worldX = minX - kTreeCanopyRadius; worldX < minX + kChunkSize + kTreeCanopyRadius; ++worldX)
+        {
+            int surface = 0;
+            if (!FindTree(worldX, worldZ, seed, surface))
+            {
+                continue;
+            }
 
-                for (int oz = -2; oz <= 2; ++oz)
+            for (int oz = -kTreeCanopyRadius; oz <= kTreeCanopyRadius; ++oz)
+            {
+                for (int ox = -kTreeCanopyRadius; ox <= kTreeCanopyRadius; ++ox)
                 {
-                    for (int ox = -2; ox <= 2; ++ox)
+                    for (int oy = 3; oy <= 5; ++oy)
                     {
-                        for (int oy = 3; oy <= 5; ++oy)
+                        if ((std::abs(ox) + std::abs(oz) + std::abs(oy - 4)) > 4)
                         {
-                            if ((std::abs(ox) + std::abs(oz) + std::abs(oy - 4)) > 4)
-                            {
-                                continue;
-                            }
-
-                            const int ly = surface + oy;
-                            if (ly >= kWorldHeight)
-                            {
-                                continue;
-                            }
-
-                            if (GetBlock(worldX + ox, ly, worldZ + oz) == BlockType::Air)
-                            {
-                                const bool changed = SetBlock(worldX + ox, ly, worldZ + oz, BlockType::Leaves);
-                                (void)changed;
-                            }
+                            continue;
                         }
+
+                        place(worldX + ox, surface + oy, worldZ + oz, BlockType::Leaves, true);
                     }
                 }
             }
@@ -376,7 +1110,19 @@ void VoxelWorld::GenerateChunk(const ChunkCoord& coord, Chunk& chunk)
     }
 }
 
-int VoxelWorld::ComputeTerrainHeight(const int worldX, const int worldZ) const
+bool VoxelWorld::FindTree(const int worldX, const int worldZ, const int seed, int& outSurface)
+{
+    // The hash is far cheaper than the height, so it goes first.
+    if ((Hash2D(worldX, worldZ, seed + 91) % 97U) != 0U)
+    {
+        return false;
+    }
+
+    outSurface = ComputeTerrainHeight(worldX, worldZ, seed);
+    return outSurface > 10;
+}
+
+int VoxelWorld::ComputeTerrainHeight(const int worldX, const int worldZ, const int seed)
 {
     const float fx = static_cast<float>(worldX);
     const float fz = static_cast<float>(worldZ);
@@ -384,7 +1130,7 @@ int VoxelWorld::ComputeTerrainHeight(const int worldX, const int worldZ) const
     const float hills = std::sin(fx * 0.11f) * 4.0f;
     const float ridges = std::cos(fz * 0.09f) * 5.0f;
     const float rolling = std::sin((fx + fz) * 0.045f) * 3.0f;
-    const float noise = static_cast<float>(Hash2D(worldX, worldZ, m_seed) & 0xFFu) / 255.0f;
+    const float noise = static_cast<float>(Hash2D(worldX, worldZ, seed) & 0xFFu) / 255.0f;
 
     float height = 18.0f + hills + ridges + rolling + ((noise - 0.5f) * 4.0f);
     height = std::clamp(height, 2.0f, static_cast<float>(kWorldHeight - 2));
@@ -1,12 +1,15 @@
 #pragma once
 
+#include <array>
 #include <cstddef>
 #include <cstdint>
 #include <utility>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #include "Engine/Math/Vector3.h"
+#include "Game/Minecraft/PalettedBlockStorage.h"
 
 namespace rg::minecraft
 {
@@ -37,20 +40,119 @@ struct BlockHit
     BlockType block = BlockType::Air;
 };
 
+struct BlockEdit
+{
+    int x = 0;
+    int y = 0;
+    int z = 0;
+    BlockType type = BlockType::Air;
+};
+
+struct VoxelRay
+{
+    Vector3 origin;
+    Vector3 direction;
+    float maxDistance = 0.0f;
+};
+
 class VoxelWorld
 {
 public:
     static constexpr int kChunkSize = 16;
     static constexpr int kWorldHeight = 64;
 
+    static constexpr std::size_t kChunkVolume = static_cast<std::size_t>(kChunkSize) * kChunkSize * kWorldHeight;
+    // Chunks are stacks of cubic sections, counted from y = 0.
+    static constexpr int kSectionSize = kChunkSize;
+    static constexpr int kSectionCount = kWorldHeight / kSectionSize;
+    static constexpr std::size_t kSectionVolume = static_cast<std::size_t>(kSectionSize) * kSectionSize * kSectionSize;
+
+    // Block storage of one chunk. A section holding a single block type (open sky,
+    // deep stone) is uniform and allocates nothing.
+    struct Chunk
+    {
+        // Every section starts as uniform air of the full section size.
+        Chunk()
+        {
+            sections.fill(PalettedBlockStorage(kSectionVolume, static_cast<std::uint8_t>(BlockType::Air)));
+        }
+
+        std::array<PalettedBlockStorage, kSectionCount> sections;
+        // Highest solid block of each column (localZ * kChunkSize + localX), 0 for
+        // an empty column. Kept up to date by FillChunk and SetBlock.
+        std::array<std::uint8_t, static_cast<std::size_t>(kChunkSize) * kChunkSize> heights {};
+        // World revision of the last change that affects this chunk's mesh: its own
+        // blocks, a neighbor's border blocks or a neighbor appearing or leaving.
+        std::uint64_t revision = 0;
+    };
+
+    // Chunks are generated in parallel on the job system; each chunk depends only
+    // on the seed, so the result does not depend on scheduling.
     void Generate(int radiusInChunks, int seed);
 
+    // Removes every chunk and switches to the given seed. Chunks are then added one
+    // by one through InsertChunk (streaming).
+    void Reset(int seed);
+
+    // Builds a chunk for the given seed without touching any world, so it can run
+    // on any thread.
+    [[nodiscard]] static Chunk GenerateChunk(int chunkX, int chunkZ, int seed);
+    // Adds or replaces a chunk. Its neighbors count as changed as well, since their
+    // border faces depend on it.
+    void InsertChunk(int chunkX, int chunkZ, Chunk chunk);
+    bool RemoveChunk(int chunkX, int chunkZ);
+    [[nodiscard]] bool HasChunk(int chunkX, int chunkZ) const;
+    // 0 when the chunk is not loaded.
+    [[nodiscard]] std::uint64_t ChunkRevision(int chunkX, int chunkZ) const;
+    [[nodiscard]] static int ToChunkCoordinate(int worldCoordinate);
+
+    // Consumers of chunk changes (renderer, saver, lighting) each register a
+    // tracker and drain their own set of dirty chunks, so none has to rescan the
+    // world. A chunk is dirty when its blocks change, when a neighbor's border
+    // blocks change, when a neighbor is loaded or unloaded, and when it is loaded
+    // or unloaded itself; HasChunk() tells the last case apart.
+    using DirtyTrackerId = std::size_t;
+    // A new tracker starts with every loaded chunk dirty.
+    [[nodiscard]] DirtyTrackerId RegisterDirtyTracker();
+    void UnregisterDirtyTracker(DirtyTrackerId tracker);
+    // Replaces outChunks with the tracker's dirty chunks and clears its set.
+    void DrainDirtyChunks(DirtyTrackerId tracker, std::vector<std::pair<int, int>>& outChunks);
+
+    // Lets the mesher and the raycaster skip whole sections. Sections of unloaded
+    // chunks and outside the world height read as uniform air.
+    [[nodiscard]] bool IsSectionUniform(int chunkX, int sectionY, int chunkZ, BlockType* outBlock = nullptr) const;
+    [[nodiscard]] bool IsSectionEmpty(int chunkX, int sectionY, int chunkZ) const;
+
     [[nodiscard]] BlockType GetBlock(int x, int y, int z) const;
+    // Fails (returns false) outside the loaded chunks.
     [[nodiscard]] bool SetBlock(int x, int y, int z, BlockType type);
+
+    // Bulk edits. Each call bumps the world revision once and marks every chunk it
+    // changed (and neighbors across changed borders) dirty once. The region edits
+    // unpack each touched section, edit it as a plain array and pack it again.
+    // Boxes are inclusive and may be given by any two opposite corners. Blocks
+    // outside the loaded chunks are skipped. Each returns the number of blocks it
+    // changed.
+    std::size_t FillBox(int x0, int y0, int z0, int x1, int y1, int z1, BlockType type);
+    // Blocks whose centers lie within radius of center.
+    std::size_t FillSphere(const Vector3& center, float radius, BlockType type);
+    std::size_t ReplaceInRegion(int x0, int y0, int z0, int x1, int y1, int z1, BlockType from, BlockType to);
+    // Arbitrary edits (brushes, structures, explosions), applied in order, so when
+    // two edits hit the same block the later one wins.
+    std::size_t EditBatch(const std::vector<BlockEdit>& edits);
+    // Height of the highest solid block in the column, 0 if there is none or the
+    // chunk is not loaded. A lookup in the chunk's heightmap.
     [[nodiscard]] int SurfaceHeight(int x, int z) const;
+    // Walks the grid cell by cell and stops at the first solid block. The hit
+    // reports the face the ray entered through and the distance to it.
     [[nodiscard]] bool Raycast(const Vector3& origin, const Vector3& direction, float maxDistance, BlockHit& outHit) const;
+    // Casts a batch of rays (line-of-sight checks and the like) on the job system;
+    // outHits[i] answers rays[i]. The world must not change while this runs.
+    void RaycastMany(const std::vector<VoxelRay>& rays, std::vector<BlockHit>& outHits) const;
 
     [[nodiscard]] std::size_t LoadedChunkCount() const;
+    // Bytes of block storage and heightmaps held by the loaded chunks.
+    [[nodiscard]] std::size_t MemoryBytes() const;
     [[nodiscard]] std::vector<std::pair<int, int>> ChunkCoordinates() const;
     [[nodiscard]] std::uint64_t Revision() const;
     [[nodiscard]] int RadiusInChunks() const;
@@ -78,25 +180,64 @@ private:
         [[nodiscard]] std::size_t operator()(const ChunkCoord& coord) const;
     };
 
-    struct Chunk
-    {
-        std::vector<std::uint8_t> blocks;
-    };
-
     [[nodiscard]] static int FloorDiv(int value, int divisor);
     [[nodiscard]] static int PositiveMod(int value, int divisor);
+    // Dense chunk layout, y-major, so section s is the range starting at
+    // s * kSectionVolume; with y taken modulo kSectionSize it indexes a section.
     [[nodiscard]] static std::size_t Index(int localX, int y, int localZ);
+    [[nodiscard]] static std::size_t ColumnIndex(int localX, int localZ);
+    // Highest solid block in the column at or below maxY, 0 if there is none.
+    [[nodiscard]] static int ScanColumn(const Chunk& chunk, int localX, int localZ, int maxY);
     [[nodiscard]] static std::uint32_t Hash2D(int x, int z, int seed);
 
+    // Changes the bulk edits made to one chunk, applied by CommitEdits.
+    struct EditedChunk
+    {
+        ChunkCoord coord;
+        Chunk* chunk = nullptr;
+        std::size_t changedBlocks = 0;
+        // Columns whose top block was removed, by ColumnIndex.
+        std::array<bool, static_cast<std::size_t>(kChunkSize) * kChunkSize> rescanColumns {};
+        bool westBorder = false;
+        bool eastBorder = false;
+        bool northBorder = false;
+        bool southBorder = false;
+    };
+
+    // Calls edit(x, y, z, current) for every block of the loaded chunks in the box
+    // and stores the returned type.
+    template <typename EditFunc>
+    std::size_t EditRegion(int x0, int y0, int z0, int x1, int y1, int z1, const EditFunc& edit);
+    // Records one changed block and keeps the chunk's heightmap current.
+    static void NoteEdit(EditedChunk& edited, int localX, int y, int localZ, BlockType type);
+    // Updates heightmaps, revisions and dirty sets for the edited chunks and the
+    // neighbors whose border they changed.
+    void CommitEdits(const std::vector<EditedChunk>& edited);
+
     [[nodiscard]] const Chunk* FindChunk(int chunkX, int chunkZ) const;
     [[nodiscard]] Chunk* FindChunk(int chunkX, int chunkZ);
-    Chunk& EnsureChunk(int chunkX, int chunkZ);
-    void GenerateChunk(const ChunkCoord& coord, Chunk& chunk);
-    [[nodiscard]] int ComputeTerrainHeight(int worldX, int worldZ) const;
+    // Stamps a loaded chunk with the current revision.
+    void TouchChunk(int chunkX, int chunkZ);
+    void TouchNeighbors(int chunkX, int chunkZ);
+    // Adds the chunk to every tracker's dirty set, loaded or not.
+    void MarkDirty(int chunkX, int chunkZ);
+    void MarkAllDirty();
+
+    // Fills a chunk from scratch. Writes only to that chunk, so different chunks
+    // can be generated concurrently.
+    static void FillChunk(const ChunkCoord& coord, int seed, Chunk& chunk);
+    // Both passes write a dense kChunkVolume array, which FillChunk then packs.
+    static void GenerateTerrain(const ChunkCoord& coord, int seed, std::vector<std::uint8_t>& blocks);
+    static void DecorateChunk(const ChunkCoord& coord, int seed, std::vector<std::uint8_t>& blocks);
+    // True if a tree grows from the given column; outSurface is its ground height.
+    [[nodiscard]] static bool FindTree(int worldX, int worldZ, int seed, int& outSurface);
+    [[nodiscard]] static int ComputeTerrainHeight(int worldX, int worldZ, int seed);
 
     int m_radiusInChunks = 0;
     int m_seed = 1337;
     std::uint64_t m_revision = 0;
     std::unordered_map<ChunkCoord, Chunk, ChunkCoordHasher> m_chunks;
+    DirtyTrackerId m_nextDirtyTracker = 1;
+    std::unordered_map<DirtyTrackerId, std::unordered_set<ChunkCoord, ChunkCoordHasher>> m_dirtyChunks;
 };
 } // namespace rg::minecraft
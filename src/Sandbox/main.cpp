@@ -1,7 +1,10 @@
+#include <cstdlib>
+#include <string_view>
+
 #include "Engine/Engine.h"
 #include "Engine/Rendering/RenderAPI.h"
 
-int main()
+int main(int argc, char** argv)
 {
     rg::EngineConfig config;
     config.projectName = "VoxelCraftPrototype";
@@ -16,6 +19,40 @@ int main()
     config.maxFrames = 1000000;
     config.fixedDeltaSeconds = 1.0f / 60.0f;
 
+    // --headless [--frames N] [--seconds S]: simulation benchmark without a display.
+    // --trace FILE: write a Chrome trace of the profiler zones on exit.
+    // --log FILE: mirror log output to a file.
+    // --stream: stream the voxel world around the player instead of a fixed square.
+    for (int index = 1; index < argc; ++index)
+    {
+        const std::string_view argument = argv[index];
+        const bool hasValue = (index + 1) < argc;
+        if (argument == "--headless")
+        {
+            config.headless = true;
+        }
+        else if ((argument == "--frames") && hasValue)
+        {
+            config.maxFrames = static_cast<std::uint32_t>(std::strtoul(argv[++index], nullptr, 10));
+        }
+        else if ((argument == "--seconds") && hasValue)
+        {
+            config.maxRunSeconds = std::strtod(argv[++index], nullptr);
+        }
+        else if ((argument == "--trace") && hasValue)
+        {
+            config.profilerTracePath = argv[++index];
+        }
+        else if (argument == "--stream")
+        {
+            config.voxelStreaming = true;
+        }
+        else if ((argument == "--log") && hasValue)
+        {
+            config.logFilePath = argv[++index];
+        }
+    }
+
     rg::Engine engine(config);
     if (!engine.Initialize())
     {